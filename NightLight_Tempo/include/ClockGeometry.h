@@ -0,0 +1,107 @@
+// File: ClockGeometry.h
+
+#pragma once
+
+#include "DirtyRegion.h"
+
+#include <cmath>
+#include <cstdint>
+#include <ctime>
+
+// The clock only ever needs the 60 minute positions, so the hand and tick offsets are computed at compile time.
+
+constexpr double CLOCK_PI = 3.14159265358979323846;
+
+constexpr double sinSeries(double x2, double term, int n) {
+    return n > 10 ? term : term + sinSeries(x2, -term * x2 / ((2 * n) * (2 * n + 1)), n + 1);
+}
+
+constexpr double cosSeries(double x2, double term, int n) {
+    return n > 10 ? term : term + cosSeries(x2, -term * x2 / ((2 * n - 1) * (2 * n)), n + 1);
+}
+
+// The series are precise enough for angles within [-PI, PI].
+constexpr double wrapAngle(double phi) {
+    return phi < -CLOCK_PI ? phi + 2 * CLOCK_PI : phi;
+}
+
+constexpr double stophi(int s) {
+    return wrapAngle(CLOCK_PI * (15 - s) / 30);
+}
+
+constexpr int roundToInt(double v) {
+    return v < 0 ? int(v - 0.5) : int(v + 0.5);
+}
+
+// Pixel offset from the center with y pointing up.
+struct ArmOffset {
+    int8_t dx;
+    int8_t dy;
+};
+
+#define ARM_OFFSET(len, s) {int8_t(roundToInt((len) * cosSeries(stophi(s) * stophi(s), 1, 1))), \
+                            int8_t(roundToInt((len) * sinSeries(stophi(s) * stophi(s), stophi(s), 1)))}
+#define ARM_OFFSETS_5(len, s) ARM_OFFSET(len, s), ARM_OFFSET(len, s + 1), ARM_OFFSET(len, s + 2), \
+                              ARM_OFFSET(len, s + 3), ARM_OFFSET(len, s + 4)
+#define ARM_OFFSETS(len) ARM_OFFSETS_5(len, 0), ARM_OFFSETS_5(len, 5), ARM_OFFSETS_5(len, 10), \
+                         ARM_OFFSETS_5(len, 15), ARM_OFFSETS_5(len, 20), ARM_OFFSETS_5(len, 25), \
+                         ARM_OFFSETS_5(len, 30), ARM_OFFSETS_5(len, 35), ARM_OFFSETS_5(len, 40), \
+                         ARM_OFFSETS_5(len, 45), ARM_OFFSETS_5(len, 50), ARM_OFFSETS_5(len, 55)
+
+template <int LEN>
+struct ArmTable {
+    static constexpr ArmOffset offsets[60] = {ARM_OFFSETS(LEN)};
+};
+
+template <int LEN>
+constexpr ArmOffset ArmTable<LEN>::offsets[60];
+
+#undef ARM_OFFSETS
+#undef ARM_OFFSETS_5
+#undef ARM_OFFSET
+
+static_assert(ArmTable<63>::offsets[0].dx == 0 && ArmTable<63>::offsets[0].dy == 63, "12 o'clock points up");
+static_assert(ArmTable<63>::offsets[15].dx == 63 && ArmTable<63>::offsets[15].dy == 0, "3 o'clock points right");
+static_assert(ArmTable<63>::offsets[30].dx == 0 && ArmTable<63>::offsets[30].dy == -63, "6 o'clock points down");
+static_assert(ArmTable<63>::offsets[45].dx == -63 && ArmTable<63>::offsets[45].dy == 0, "9 o'clock points left");
+static_assert(ArmTable<40>::offsets[5].dx == 20 && ArmTable<40>::offsets[5].dy == 35, "1 o'clock is at 30 degrees");
+
+// The hour, minute and second hand - their positions are in minute steps.
+constexpr int HAND_COUNT = 3;
+constexpr int HAND_LENGTHS[HAND_COUNT] = {40, 58, 62};
+
+// The fraction of the second lets the second hand sweep instead of tick.
+inline void handPositions(const struct tm& timeinfo, float secondFraction, float (&positions)[HAND_COUNT]) {
+    positions[0] = float(timeinfo.tm_hour * 5 + timeinfo.tm_min / 12);
+    positions[1] = float(timeinfo.tm_min);
+    positions[2] = timeinfo.tm_sec + secondFraction;
+}
+
+// From the tables at the 60 positions, computed in between - for the sweeping second hand.
+inline ArmOffset handOffset(int hand, float position) {
+    static const ArmOffset (*const arms[HAND_COUNT])[60] = {
+        &ArmTable<40>::offsets, &ArmTable<58>::offsets, &ArmTable<62>::offsets
+    };
+    if (position == floorf(position)) {
+        return (*arms[hand])[int(position) % 60];
+    }
+    const float phi = float(CLOCK_PI) * (15 - position) / 30;
+    return {int8_t(lroundf(HAND_LENGTHS[hand] * cosf(phi))), int8_t(lroundf(HAND_LENGTHS[hand] * sinf(phi)))};
+}
+
+// Hands are lines from the center at 64, 64.
+inline Rect handBounds(int hand, float position) {
+    const ArmOffset off = handOffset(hand, position);
+    return lineBounds(64, 64, 64 + off.dx, 64 - off.dy);
+}
+
+// What a frame of the analog clock repaints - the old and new bounds of every hand which moved.
+inline Rect handDamage(const float (&from)[HAND_COUNT], const float (&to)[HAND_COUNT]) {
+    Rect damage{};
+    for (int i = 0; i < HAND_COUNT; ++i) {
+        if (from[i] != to[i]) {
+            damage = damage.united(handBounds(i, from[i])).united(handBounds(i, to[i]));
+        }
+    }
+    return damage;
+}
@@ -0,0 +1,92 @@
+// File: DirtyRegion.h
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+struct Rect {
+    int16_t x;
+    int16_t y;
+    int16_t w;
+    int16_t h;
+
+    bool isEmpty() const {
+        return w <= 0 || h <= 0;
+    }
+
+    int16_t right() const { return x + w; }
+    int16_t bottom() const { return y + h; }
+
+    bool intersects(const Rect& other) const {
+        return x <= other.right() && other.x <= right() && y <= other.bottom() && other.y <= bottom();
+    }
+
+    Rect united(const Rect& other) const {
+        if (isEmpty()) {
+            return other;
+        }
+        if (other.isEmpty()) {
+            return *this;
+        }
+        const int16_t l = std::min(x, other.x);
+        const int16_t t = std::min(y, other.y);
+        return {l, t, int16_t(std::max(right(), other.right()) - l), int16_t(std::max(bottom(), other.bottom()) - t)};
+    }
+
+    Rect clipped(const Rect& bounds) const {
+        const int16_t l = std::max(x, bounds.x);
+        const int16_t t = std::max(y, bounds.y);
+        const int16_t r = std::min(right(), bounds.right());
+        const int16_t b = std::min(bottom(), bounds.bottom());
+        return {l, t, int16_t(std::max(0, r - l)), int16_t(std::max(0, b - t))};
+    }
+};
+
+inline Rect lineBounds(int x0, int y0, int x1, int y1) {
+    return {int16_t(std::min(x0, x1)), int16_t(std::min(y0, y1)), int16_t(std::abs(x1 - x0) + 1), int16_t(std::abs(y1 - y0) + 1)};
+}
+
+// Keeps a few disjoint dirty rects; touching ones are merged and on overflow the last one absorbs the new one.
+class DirtyRegion {
+public:
+    static constexpr int MAX_RECTS = 4;
+
+    void add(const Rect& rect) {
+        Rect r = rect;
+        if (r.isEmpty()) {
+            return;
+        }
+        // Merging can make the grown rect touch others, so repeat until stable.
+        for (int i = 0; i < count_;) {
+            if (rects_[i].intersects(r)) {
+                r = r.united(rects_[i]);
+                rects_[i] = rects_[--count_];
+                i = 0;
+            } else {
+                ++i;
+            }
+        }
+        if (count_ == MAX_RECTS) {
+            rects_[count_ - 1] = rects_[count_ - 1].united(r);
+        } else {
+            rects_[count_++] = r;
+        }
+    }
+
+    void clear() {
+        count_ = 0;
+    }
+
+    bool isEmpty() const {
+        return count_ == 0;
+    }
+
+    const Rect* begin() const { return rects_; }
+    const Rect* end() const { return rects_ + count_; }
+
+private:
+    Rect rects_[MAX_RECTS];
+    int count_ = 0;
+};
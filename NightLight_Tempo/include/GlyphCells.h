@@ -0,0 +1,64 @@
+// File: GlyphCells.h
+
+#pragma once
+
+#include "DirtyRegion.h"
+
+#include <algorithm>
+#include <cstdint>
+
+// A line of text split into one cell per glyph, so only the cells whose glyph changed need to be repainted.
+struct TextLine {
+    static constexpr int MAX_GLYPHS = 15;
+
+    uint8_t len;
+    char glyphs[MAX_GLYPHS];
+    int16_t xs[MAX_GLYPHS + 1]; // Glyph cell starts, with the end of the last cell at xs[len].
+
+    // Lays the text out from x - advance returns the width of a glyph in the current font.
+    template <typename Advance>
+    static TextLine layout(const char* text, int16_t x, Advance advance) {
+        TextLine line{};
+        line.xs[0] = x;
+        for (const char* c = text; *c && line.len < MAX_GLYPHS; ++c, ++line.len) {
+            line.glyphs[line.len] = *c;
+            line.xs[line.len + 1] = line.xs[line.len] + advance(*c);
+        }
+        return line;
+    }
+};
+
+// The cells which differ between two layouts of a line.
+struct CellDiff {
+    int count;                            // The cells compared - of the longer line.
+    bool changed[TextLine::MAX_GLYPHS];
+    Rect cells[TextLine::MAX_GLYPHS];     // Old and new extent of each changed cell - these have to be erased.
+    Rect damage;
+
+    // Neighbours are drawn again too, in case their glyphs reach into an erased cell.
+    bool needsDraw(int i) const {
+        return changed[i] || (i > 0 && changed[i - 1]) || (i + 1 < count && changed[i + 1]);
+    }
+};
+
+inline CellDiff diffCells(const TextLine& line, const TextLine& next, int16_t y, int16_t height) {
+    CellDiff diff{};
+    diff.count = std::max(line.len, next.len);
+    for (int i = 0; i < diff.count; ++i) {
+        diff.changed[i] = i >= line.len || i >= next.len
+            || line.glyphs[i] != next.glyphs[i] || line.xs[i] != next.xs[i] || line.xs[i + 1] != next.xs[i + 1];
+        if (!diff.changed[i]) {
+            continue;
+        }
+        Rect cell{};
+        if (i < line.len) {
+            cell = {line.xs[i], y, int16_t(line.xs[i + 1] - line.xs[i]), height};
+        }
+        if (i < next.len) {
+            cell = cell.united({next.xs[i], y, int16_t(next.xs[i + 1] - next.xs[i]), height});
+        }
+        diff.cells[i] = cell;
+        diff.damage = diff.damage.united(cell);
+    }
+    return diff;
+}
@@ -0,0 +1,79 @@
+// File: IoWorker.h
+
+#pragma once
+
+#include <Arduino.h>
+
+// A blocking operation - like a network request - which runs on the I/O worker instead of in a tick.
+class IoJob {
+public:
+    virtual ~IoJob() = default;
+
+    // From posting the job until its completion got delivered - await it becoming false for the results.
+    bool isPending() const {
+        return isPending_;
+    }
+
+protected:
+    // Runs on the worker task - results must only be read once the job completed.
+    virtual void run() = 0;
+
+private:
+    friend class IoWorker;
+
+    bool isPending_ = false;
+};
+
+// One long-lived task with a bounded queue runs all blocking I/O one job after the other, so there is one stack
+// for it instead of a thread per request. Completions get handed back to the activities before the next tick.
+class IoWorker {
+public:
+    static constexpr int QUEUE_LENGTH = 4;
+
+    void init() {
+        jobs_ = xQueueCreate(QUEUE_LENGTH, sizeof(IoJob*));
+        // Each job can only be queued once, so with the one in progress this never fills up.
+        completions_ = xQueueCreate(QUEUE_LENGTH + 1, sizeof(IoJob*));
+        xTaskCreatePinnedToCore(staticRunner, "IoWorker", 1024 * 8, this, 1, nullptr, 1);
+    }
+
+    // Returns false if the job is still pending or the queue is full.
+    bool post(IoJob& job) {
+        if (job.isPending_) {
+            return false;
+        }
+        IoJob* ptr = &job;
+        if (xQueueSend(jobs_, &ptr, 0) != pdTRUE) {
+            return false;
+        }
+        job.isPending_ = true;
+        return true;
+    }
+
+    // Called before each tick on the activity task.
+    void deliverCompletions() {
+        IoJob* job;
+        while (xQueueReceive(completions_, &job, 0) == pdTRUE) {
+            job->isPending_ = false;
+        }
+    }
+
+private:
+    static void staticRunner(void* self) {
+        reinterpret_cast<IoWorker*>(self)->runner();
+    }
+
+    void runner() {
+        while (true) {
+            IoJob* job;
+            if (xQueueReceive(jobs_, &job, portMAX_DELAY) == pdTRUE) {
+                job->run();
+                xQueueSend(completions_, &job, portMAX_DELAY);
+            }
+        }
+    }
+
+private:
+    QueueHandle_t jobs_{};
+    QueueHandle_t completions_{};
+};
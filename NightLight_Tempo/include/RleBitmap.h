@@ -0,0 +1,68 @@
+// File: RleBitmap.h
+
+#pragma once
+
+#include <cstdint>
+
+// A palette-indexed, run-length encoded RGB565 bitmap.
+//
+// The runs cover the pixels row by row, a run may continue on the next row.
+// Each run starts with a byte holding the palette index in the upper 6 bits and the length in the lower 2 bits:
+// 0-2 stand for runs of 1-3 pixels, 3 means the next byte holds the length minus 4.
+struct RleBitmap {
+    uint8_t width;
+    uint8_t height;
+    const uint16_t* palette;
+    uint8_t paletteSize;
+    const uint8_t* runs;
+    uint16_t runsSize;
+};
+
+// Calls span(x, y, length, color) for each horizontal span of the bitmap - runs which continue on the next row are
+// split into one span per row.
+// Returns false if the runs are malformed - if they refer to a color beyond the palette, lack the length byte of a long
+// run, overflow the bitmap or do not cover it completely. The spans up to the malformed run have been called then.
+template <typename Span>
+bool forEachRleSpan(const RleBitmap& bitmap, Span span) {
+    if (bitmap.width == 0 || bitmap.height == 0) {
+        return false;
+    }
+
+    const uint8_t* const end = bitmap.runs + bitmap.runsSize;
+    int32_t col = 0;
+    int32_t row = 0;
+
+    for (const uint8_t* run = bitmap.runs; run < end; ++run) {
+        if ((*run >> 2) >= bitmap.paletteSize) {
+            return false;
+        }
+        const uint16_t color = bitmap.palette[*run >> 2];
+        int32_t len = (*run & 0b11) + 1;
+        if (len == 4) {
+            if (++run == end) {
+                return false;
+            }
+            len = *run + 4;
+        }
+
+        while (len > 0) {
+            if (row == bitmap.height) {
+                return false;
+            }
+            const int32_t n = len < bitmap.width - col ? len : bitmap.width - col;
+            span(col, row, n, color);
+            len -= n;
+            col += n;
+            if (col == bitmap.width) {
+                col = 0;
+                ++row;
+            }
+        }
+    }
+    return col == 0 && row == bitmap.height;
+}
+
+// Whether the runs cover the bitmap exactly and only refer to colors of the palette.
+inline bool isRleBitmapValid(const RleBitmap& bitmap) {
+    return forEachRleSpan(bitmap, [](int32_t, int32_t, int32_t, uint16_t) {});
+}
@@ -0,0 +1,43 @@
+// File: SecondBoundary.h
+
+#pragma once
+
+#include <sys/time.h>
+#include <ctime>
+
+// Until SNTP sets it the wall clock counts from the epoch - like getLocalTime() of the Arduino core, a clock in 2016
+// or earlier counts as not set.
+inline bool isClockSet(const struct tm& timeinfo) {
+    return timeinfo.tm_year > 2016 - 1900;
+}
+
+inline bool isClockSet(time_t time) {
+    struct tm timeinfo;
+    localtime_r(&time, &timeinfo);
+    return isClockSet(timeinfo);
+}
+
+// Holds on the first tick after each second boundary of the wall clock - unlike pa_every_s which is phase-locked
+// to the activation and can therefore lag the real second by up to a second.
+class SecondBoundary {
+public:
+    void reset() {
+        lastSec_ = 0;
+    }
+
+    bool crossed() {
+        struct timeval tv;
+        gettimeofday(&tv, nullptr);
+        return crossed(tv.tv_sec);
+    }
+
+    // Returns true if the given second of the wall clock differs from the one of the previous call.
+    bool crossed(time_t sec) {
+        const bool didCross = sec != lastSec_;
+        lastSec_ = sec;
+        return didCross;
+    }
+
+private:
+    time_t lastSec_ = 0;
+};
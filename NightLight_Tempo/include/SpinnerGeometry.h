@@ -0,0 +1,71 @@
+// File: SpinnerGeometry.h
+
+#pragma once
+
+#include "DirtyRegion.h"
+
+#include <algorithm>
+#include <cmath>
+
+// The arc of the wait spinner around the screen center at 64, 64.
+
+constexpr float SPINNER_DEG_TO_RAD = 3.14159265358979323846f / 180;
+
+constexpr auto ARC_LEN = 180.0 / 4.0;
+constexpr auto ARC_INC = 180.0 / 10.0;
+constexpr int ARC_INNER_RADIUS = 20;
+constexpr int ARC_OUTER_RADIUS = 30;
+
+inline Rect arcBounds(float from, float to) {
+    float minX = 64 + ARC_INNER_RADIUS * cosf(from * SPINNER_DEG_TO_RAD);
+    float maxX = minX;
+    float minY = 64 + ARC_INNER_RADIUS * sinf(from * SPINNER_DEG_TO_RAD);
+    float maxY = minY;
+    auto include = [&](float deg, int r) {
+        const float rad = deg * SPINNER_DEG_TO_RAD;
+        const float x = 64 + r * cosf(rad);
+        const float y = 64 + r * sinf(rad);
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+    };
+
+    include(to, ARC_INNER_RADIUS);
+    include(from, ARC_OUTER_RADIUS);
+    include(to, ARC_OUTER_RADIUS);
+    // The arc bulges out at every axis it crosses.
+    for (float deg = ceilf(from / 90) * 90; deg < to; deg += 90) {
+        include(deg, ARC_OUTER_RADIUS);
+    }
+
+    // One pixel of slack for the rounding of the rasterizer.
+    const int16_t l = floorf(minX) - 1;
+    const int16_t t = floorf(minY) - 1;
+    return {l, t, int16_t(ceilf(maxX) + 2 - l), int16_t(ceilf(maxY) + 2 - t)};
+}
+
+// One frame of the spinner moving its arc on by ARC_INC.
+//
+// Only the trailing segment the arc leaves gets erased - by filling its bounds, as erasing it with fillArc might leave
+// behind what the rasterizer set at the old start of the arc. Then the whole arc gets drawn again, which restores the
+// pixels of the remaining arc within those bounds and adds the leading segment. So only the bounds of the trailing
+// and the leading segment change on the screen. On every full turn the arc changes its color, then the whole old
+// and new arc change.
+struct SpinnerStep {
+    float angle;      // Where the arc starts after the step, in [0, 360).
+    bool isRecolored;
+    Rect erase;
+    Rect damage[2];
+};
+
+inline SpinnerStep spinnerStep(float angle) {
+    const float next = angle + ARC_INC;
+    const bool isRecolored = next >= 360;
+    const Rect trailing = arcBounds(angle, next);
+    if (isRecolored) {
+        const Rect all = arcBounds(angle, next + ARC_LEN);
+        return {next - 360, true, all, {all, Rect{}}};
+    }
+    return {next, false, trailing, {trailing, arcBounds(angle + ARC_LEN, next + ARC_LEN)}};
+}
@@ -0,0 +1,67 @@
+// File: SymbolBundle.h
+
+#pragma once
+
+#include "RleBitmap.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// The index of the weather symbol bundle written by scripts/weather_symbols.py - see there for the layout.
+class SymbolBundleIndex {
+public:
+    static constexpr int SYMBOL_COUNT = 100;
+    static constexpr uint8_t VERSION = 1;
+    static constexpr int INDEX_ENTRY_SIZE = 6;
+    static constexpr int HEADER_SIZE = 8 + SYMBOL_COUNT * INDEX_ENTRY_SIZE;
+    static constexpr int RECORD_HEADER_SIZE = 4;
+
+    struct Entry {
+        uint32_t offset;
+        uint16_t length;
+    };
+
+    // Returns false if the header is not the one of a bundle in this version.
+    bool parse(const uint8_t (&header)[HEADER_SIZE]) {
+        if (memcmp(header, "WSYM", 4) != 0 || header[4] != VERSION || header[5] != SYMBOL_COUNT) {
+            return false;
+        }
+        for (int i = 0; i < SYMBOL_COUNT; ++i) {
+            const uint8_t* entry = header + 8 + i * INDEX_ENTRY_SIZE;
+            index_[i].offset = entry[0] | entry[1] << 8 | entry[2] << 16 | uint32_t(entry[3]) << 24;
+            index_[i].length = entry[4] | entry[5] << 8;
+        }
+        return true;
+    }
+
+    // Unknown codes resolve to the symbol of code 0.
+    const Entry& entryOf(int weatherCode) const {
+        if (weatherCode < 0 || weatherCode >= SYMBOL_COUNT) {
+            weatherCode = 0;
+        }
+        return index_[weatherCode];
+    }
+
+    // Refers into the record, which has to outlive the bitmap - returns false if the record is cut short or its runs
+    // do not decode to exactly width * height pixels of palette colors.
+    static bool bitmapOf(const uint8_t* record, size_t length, RleBitmap& bitmap) {
+        if (length < RECORD_HEADER_SIZE) {
+            return false;
+        }
+        const uint8_t paletteSize = record[2];
+        const size_t runsOffset = RECORD_HEADER_SIZE + paletteSize * sizeof(uint16_t);
+        if (runsOffset > length) {
+            return false;
+        }
+        bitmap = {
+            record[0], record[1],
+            reinterpret_cast<const uint16_t*>(record + RECORD_HEADER_SIZE), paletteSize,
+            record + runsOffset, uint16_t(length - runsOffset)
+        };
+        return isRleBitmapValid(bitmap);
+    }
+
+private:
+    Entry index_[SYMBOL_COUNT]{};
+};
@@ -0,0 +1,44 @@
+// File: TripleBuffer.h
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Hands the latest value from one producer task to one consumer task without locking - neither side ever waits, a
+// value is never read while it gets written and the consumer skips values which got overwritten before it fetched
+// them. Used between the activities and the render task as well as from background jobs back into the activities.
+template <typename T>
+class TripleBuffer {
+public:
+    // Producer side: fill the back slot, then publish it.
+    T& back() {
+        return slots_[back_];
+    }
+
+    void publish() {
+        back_ = middle_.exchange(back_ | FRESH) & INDEX;
+    }
+
+    // Consumer side: returns true if a value was published since the last fetch - front() then refers to it.
+    bool fetch() {
+        if (!(middle_.load() & FRESH)) {
+            return false;
+        }
+        front_ = middle_.exchange(front_) & INDEX;
+        return true;
+    }
+
+    const T& front() const {
+        return slots_[front_];
+    }
+
+private:
+    static constexpr uint8_t INDEX = 0x3;
+    static constexpr uint8_t FRESH = 0x4;
+
+    T slots_[3]{};
+    uint8_t back_ = 0;
+    uint8_t front_ = 1;
+    std::atomic<uint8_t> middle_{2};
+};
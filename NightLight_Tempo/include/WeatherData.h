@@ -0,0 +1,64 @@
+// File: WeatherData.h
+
+#pragma once
+
+#include <ArduinoJson.hpp>
+
+#include <cstddef>
+
+struct WeatherData {
+    bool isValid{};
+    float curTemp{};
+    float minTemp{};
+    float maxTemp{};
+    int weatherCode{};
+    int maxPercipitationProb{};
+
+    bool operator==(const WeatherData& other) const {
+        return isValid == other.isValid 
+            && curTemp == other.curTemp
+            && minTemp == other.minTemp
+            && maxTemp == other.maxTemp
+            && weatherCode == other.weatherCode
+            && maxPercipitationProb == other.maxPercipitationProb;      
+    }
+
+    bool operator!=(const WeatherData& other) const { return !(*this == other); }
+};
+
+// The response gets filtered down to the fields we show - with one forecast day each daily field is an array of one.
+// Keys read from a stream are copied into the document, hence the room for their text.
+constexpr size_t WEATHER_FILTER_CAPACITY = JSON_OBJECT_SIZE(2) + JSON_OBJECT_SIZE(1) + JSON_OBJECT_SIZE(4);
+constexpr size_t WEATHER_DOC_CAPACITY = WEATHER_FILTER_CAPACITY + 4 * JSON_ARRAY_SIZE(1) + 128;
+
+// Parses an open-meteo forecast right from the input - anything deserializeJson() reads, like the HTTP stream - into
+// the document, which needs a capacity of WEATHER_DOC_CAPACITY. The weather stays as it is unless the result is Ok.
+template <typename Input>
+ArduinoJson::DeserializationError parseWeather(Input& input, WeatherData& weather, ArduinoJson::JsonDocument& doc) {
+    ArduinoJson::StaticJsonDocument<WEATHER_FILTER_CAPACITY> filter;
+    filter["current"]["temperature_2m"] = true;
+    filter["daily"]["temperature_2m_max"] = true;
+    filter["daily"]["temperature_2m_min"] = true;
+    filter["daily"]["weather_code"] = true;
+    filter["daily"]["precipitation_probability_max"] = true;
+
+    const auto res = ArduinoJson::deserializeJson(doc, input, ArduinoJson::DeserializationOption::Filter(filter));
+    if (res.code() != ArduinoJson::DeserializationError::Ok) {
+        return res;
+    }
+
+    weather.maxTemp = doc["daily"]["temperature_2m_max"][0].as<float>();
+    weather.curTemp = doc["current"]["temperature_2m"].as<float>();
+    weather.minTemp = doc["daily"]["temperature_2m_min"][0].as<float>();
+    weather.weatherCode = doc["daily"]["weather_code"][0].as<int>();
+    weather.maxPercipitationProb = doc["daily"]["precipitation_probability_max"][0].as<int>();
+    weather.isValid = true;
+    return res;
+}
+
+// The same with the document on the stack.
+template <typename Input>
+ArduinoJson::DeserializationError parseWeather(Input& input, WeatherData& weather) {
+    ArduinoJson::StaticJsonDocument<WEATHER_DOC_CAPACITY> doc;
+    return parseWeather(input, weather, doc);
+}
@@ -0,0 +1,54 @@
+// File: WeatherRefreshPolicy.h
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <ctime>
+
+// Decides when the weather gets fetched next. After a success the next fetch waits for the following hourly model
+// update of open-meteo - fetching in between mostly returns the same data. Failures back off exponentially with
+// random jitter, so an outage of the network or of the service is probed less and less often.
+class WeatherRefreshPolicy {
+public:
+    // Open-meteo publishes the hourly model run a few minutes after the full hour.
+    static constexpr uint32_t MODEL_UPDATE_S = 60 * 60;
+    static constexpr uint32_t MODEL_DELAY_S = 10 * 60;
+    static constexpr uint32_t SPREAD_S = 2 * 60;
+    static constexpr uint32_t MIN_REFRESH_S = 5 * 60;
+
+    static constexpr uint32_t FIRST_RETRY_S = 10;
+    static constexpr uint32_t MAX_RETRY_S = 30 * 60;
+
+    // The spread lets hourly successes follow each other a bit less than an hour apart - persisting their weather at
+    // most every half hour still keeps each of them, while retries shortly after a success add no flash writes.
+    static constexpr uint32_t PERSIST_INTERVAL_S = MODEL_UPDATE_S / 2;
+
+    // Returns a number from 0 to below max - Arduino's random() on the device.
+    using Random = long (*)(long max);
+
+    explicit WeatherRefreshPolicy(Random random) : random_(random) {}
+
+    // Returns the seconds until the next fetch.
+    uint32_t onSuccess(time_t now) {
+        backoff_ = FIRST_RETRY_S;
+
+        const uint32_t intoUpdate = (static_cast<uint32_t>(now) + MODEL_UPDATE_S - MODEL_DELAY_S) % MODEL_UPDATE_S;
+        uint32_t delay = MODEL_UPDATE_S - intoUpdate;
+        if (delay < MIN_REFRESH_S) {
+            delay += MODEL_UPDATE_S;
+        }
+        return delay + random_(SPREAD_S);
+    }
+
+    // Returns the seconds until the next fetch - a random one in the upper half of the current backoff.
+    uint32_t onFailure() {
+        const uint32_t backoff = backoff_;
+        backoff_ = std::min(2 * backoff_, uint32_t(MAX_RETRY_S));
+        return backoff / 2 + random_(backoff / 2 + 1);
+    }
+
+private:
+    Random random_;
+    uint32_t backoff_ = FIRST_RETRY_S;
+};
@@ -1,212 +0,0 @@
-// File: WeatherSymbols.h
-
-#include <cstdint>
-
-#include "WeatherSymbol_WMO_PresentWeather_ww_00.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_01.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_02.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_03.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_04.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_05.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_06.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_07.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_08.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_09.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_10.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_11.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_12.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_13.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_14.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_15.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_16.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_17.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_18.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_19.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_20.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_21.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_22.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_23.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_24.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_25.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_26.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_27.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_28.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_29.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_30.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_31.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_32.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_33.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_34.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_35.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_36.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_37.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_38.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_39.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_40.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_41.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_42.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_43.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_44.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_45.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_46.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_47.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_48.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_49.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_50.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_51.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_52.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_53.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_54.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_55.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_56.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_57.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_58.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_59.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_60.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_61.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_62.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_63.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_64.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_65.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_66.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_67.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_68.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_69.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_70.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_71.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_72.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_73.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_74.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_75.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_76.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_77.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_78.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_79.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_80.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_81.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_82.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_83.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_84.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_85.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_86.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_87.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_88.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_89.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_90.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_91.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_92.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_93.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_94.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_95.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_96.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_97.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_98.h"
-#include "WeatherSymbol_WMO_PresentWeather_ww_99.h"
-
-inline const std::uint8_t* getWeatherSymbol(int weatherCode, std::size_t& weatherSymbolSize) {
-    const std::uint8_t* weatherSymbol = nullptr;
-    switch (weatherCode) {
-        case 0: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_00; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_00); break;
-        case 1: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_01; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_01); break;
-        case 2: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_02; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_02); break;
-        case 3: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_03; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_03); break;
-        case 4: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_04; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_04); break;
-        case 5: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_05; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_05); break;
-        case 6: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_06; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_06); break;
-        case 7: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_07; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_07); break;
-        case 8: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_08; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_08); break;
-        case 9: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_09; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_09); break;
-        case 10: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_10; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_10); break;
-        case 11: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_11; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_11); break;
-        case 12: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_12; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_12); break;
-        case 13: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_13; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_13); break;
-        case 14: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_14; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_14); break;
-        case 15: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_15; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_15); break;
-        case 16: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_16; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_16); break;
-        case 17: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_17; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_17); break;
-        case 18: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_18; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_18); break;
-        case 19: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_19; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_19); break;
-        case 20: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_20; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_20); break;
-        case 21: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_21; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_21); break;
-        case 22: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_22; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_22); break;
-        case 23: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_23; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_23); break;
-        case 24: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_24; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_24); break;
-        case 25: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_25; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_25); break;
-        case 26: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_26; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_26); break;
-        case 27: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_27; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_27); break;
-        case 28: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_28; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_28); break;
-        case 29: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_29; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_29); break;
-        case 30: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_30; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_30); break;
-        case 31: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_31; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_31); break;
-        case 32: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_32; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_32); break;
-        case 33: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_33; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_33); break;
-        case 34: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_34; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_34); break;
-        case 35: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_35; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_35); break;
-        case 36: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_36; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_36); break;
-        case 37: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_37; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_37); break;
-        case 38: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_38; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_38); break;
-        case 39: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_39; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_39); break;
-        case 40: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_40; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_40); break;
-        case 41: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_41; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_41); break;
-        case 42: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_42; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_42); break;
-        case 43: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_43; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_43); break;
-        case 44: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_44; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_44); break;
-        case 45: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_45; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_45); break;
-        case 46: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_46; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_46); break;
-        case 47: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_47; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_47); break;
-        case 48: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_48; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_48); break;
-        case 49: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_49; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_49); break;
-        case 50: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_50; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_50); break;
-        case 51: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_51; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_51); break;
-        case 52: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_52; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_52); break;
-        case 53: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_53; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_53); break;
-        case 54: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_54; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_54); break;
-        case 55: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_55; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_55); break;
-        case 56: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_56; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_56); break;
-        case 57: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_57; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_57); break;
-        case 58: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_58; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_58); break;
-        case 59: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_59; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_59); break;
-        case 60: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_60; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_60); break;
-        case 61: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_61; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_61); break;
-        case 62: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_62; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_62); break;
-        case 63: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_63; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_63); break;
-        case 64: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_64; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_64); break;
-        case 65: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_65; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_65); break;
-        case 66: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_66; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_66); break;
-        case 67: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_67; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_67); break;
-        case 68: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_68; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_68); break;
-        case 69: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_69; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_69); break;
-        case 70: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_70; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_70); break;
-        case 71: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_71; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_71); break;
-        case 72: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_72; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_72); break;
-        case 73: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_73; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_73); break;
-        case 74: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_74; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_74); break;
-        case 75: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_75; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_75); break;
-        case 76: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_76; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_76); break;
-        case 77: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_77; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_77); break;
-        case 78: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_78; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_78); break;
-        case 79: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_79; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_79); break;
-        case 80: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_80; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_80); break;
-        case 81: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_81; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_81); break;
-        case 82: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_82; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_82); break;
-        case 83: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_83; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_83); break;
-        case 84: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_84; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_84); break;
-        case 85: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_85; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_85); break;
-        case 86: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_86; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_86); break;
-        case 87: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_87; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_87); break;
-        case 88: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_88; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_88); break;
-        case 89: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_89; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_89); break;
-        case 90: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_90; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_90); break;
-        case 91: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_91; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_91); break;
-        case 92: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_92; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_92); break;
-        case 93: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_93; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_93); break;
-        case 94: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_94; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_94); break;
-        case 95: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_95; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_95); break;
-        case 96: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_96; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_96); break;
-        case 97: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_97; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_97); break;
-        case 98: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_98; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_98); break;
-        case 99: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_99; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_99); break;
-        default: weatherSymbol = WeatherSymbol_WMO_PresentWeather_ww_00; weatherSymbolSize = sizeof(WeatherSymbol_WMO_PresentWeather_ww_00); break;
-    }
-    return weatherSymbol;
-}
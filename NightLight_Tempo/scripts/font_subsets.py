@@ -0,0 +1,176 @@
+# Project: NightLight
+# Copyright: (c) 2025 Framework Labs
+
+# Cuts the GFX fonts used by the screens down to the glyphs they actually print and writes
+# them to include/FontSubsets.h - the full fonts of M5GFX then no longer get linked.
+#
+# Glyphs outside a subset keep their advance but lose their bitmap, and the glyph range is
+# trimmed to the first and last used character. So text with other characters does not
+# crash but shows gaps - extend SUBSETS when changing what a screen prints.
+#
+# If a font source can not be found in the library dependencies or does not parse as expected,
+# the build stops - a silent fallback to the full M5GFX fonts would hide that the subsets are gone.
+#
+# Runs as a PlatformIO pre script but can also be called directly with the directory of the
+# installed libraries:
+#   python3 scripts/font_subsets.py .pio/libdeps/m5stack-atoms3
+
+import glob
+import os
+import re
+import sys
+
+DIGITS = "0123456789"
+
+SUBSETS = {
+    # Digital clock, day on the clock face and alarm time.
+    "Roboto_Thin_24": " -:" + DIGITS,
+    # Weather code and its label.
+    "FreeSans9pt7b": " -Wetr:" + DIGITS,
+    # Temperatures, rain probability and their labels.
+    "FreeSans12pt7b": " %-.:Raimnx" + DIGITS,
+    # Current temperature.
+    "FreeSans18pt7b": " -." + DIGITS,
+}
+
+HEADER_NAME = "FontSubsets.h"
+NAMESPACE = "subset_fonts"
+
+# As laid out by lgfx::GFXglyph: u32 bitmap offset, u8 width, height and advance, s8 x and y offset.
+GLYPH_SIZE = 12
+
+
+def find_font_source(libdeps_dir, name):
+    for path in glob.glob(os.path.join(libdeps_dir, "**", name + ".h"), recursive=True):
+        with open(path, errors="replace") as f:
+            text = f.read()
+        if name + "Bitmaps" in text and name + "Glyphs" in text:
+            return text
+    return None
+
+
+def array_body(text, array_name):
+    match = re.search(re.escape(array_name) + r"\s*\[\s*\][^=]*=\s*\{", text)
+    if not match:
+        raise ValueError("array %s not found" % array_name)
+    end = text.index("};", match.end())
+    return text[match.end():end]
+
+
+def parse_font(text, name):
+    """Returns bitmap bytes, glyph tuples, first and last character and y advance of an Adafruit GFX font."""
+    bitmap = bytes(int(byte, 16) for byte in re.findall(r"0x[0-9a-fA-F]{1,2}", array_body(text, name + "Bitmaps")))
+
+    number = r"\s*(-?\d+)\s*"
+    glyph_pattern = r"\{" + ",".join([number] * 6) + r"\}"
+    glyphs = [tuple(int(v) for v in match) for match in re.findall(glyph_pattern, array_body(text, name + "Glyphs"))]
+
+    match = re.search(re.escape(name) + r"\s+(?:PROGMEM\s*)?=\s*\{([^}]*)\}", text)
+    if not match:
+        raise ValueError("font %s not found" % name)
+    fields = re.sub(r"\([^)]*\)\s*[A-Za-z_]\w*", "", match.group(1))  # Drop the casted array names.
+    first, last, y_advance = (int(v, 0) for v in re.findall(r"0x[0-9a-fA-F]+|\d+", fields))
+
+    if len(glyphs) != last - first + 1:
+        raise ValueError("font %s has %d glyphs for range 0x%02X-0x%02X" % (name, len(glyphs), first, last))
+    for code, (offset, width, height, _, _, _) in enumerate(glyphs, first):
+        if offset + (width * height + 7) // 8 > len(bitmap):
+            raise ValueError("glyph 0x%02X of font %s lies outside its %d bitmap bytes" % (code, name, len(bitmap)))
+    return bitmap, glyphs, first, last, y_advance
+
+
+def subset_font(bitmap, glyphs, first, last, chars):
+    codes = sorted(ord(c) for c in set(chars))
+    missing = [chr(code) for code in codes if not first <= code <= last]
+    if missing:
+        raise ValueError("font lacks %r" % "".join(missing))
+    sub_first = codes[0]
+    sub_last = codes[-1]
+
+    sub_bitmap = bytearray()
+    sub_glyphs = []
+    for code in range(sub_first, sub_last + 1):
+        offset, width, height, x_advance, x_offset, y_offset = glyphs[code - first]
+        if code in codes:
+            size = (width * height + 7) // 8
+            sub_glyphs.append((len(sub_bitmap), width, height, x_advance, x_offset, y_offset))
+            sub_bitmap += bitmap[offset:offset + size]
+        else:
+            sub_glyphs.append((0, 0, 0, x_advance, 0, 0))
+    return bytes(sub_bitmap), sub_glyphs, sub_first, sub_last
+
+
+def format_font(name, bitmap, glyphs, first, last, y_advance, chars):
+    lines = ["// %s: %s" % (name, "".join(sorted(set(chars))))]
+
+    lines.append("const uint8_t %sBitmaps[] PROGMEM = {" % name)
+    for pos in range(0, len(bitmap), 16):
+        lines.append("    " + ", ".join("0x%02X" % b for b in bitmap[pos:pos + 16]) + ",")
+    lines.append("};")
+
+    lines.append("const lgfx::GFXglyph %sGlyphs[] PROGMEM = {" % name)
+    for code, glyph in enumerate(glyphs, first):
+        lines.append("    { %5d, %3d, %3d, %3d, %4d, %4d }, // 0x%02X %r" % (glyph + (code, chr(code))))
+    lines.append("};")
+
+    lines.append("const lgfx::GFXfont %s((uint8_t*)%sBitmaps, (lgfx::GFXglyph*)%sGlyphs, 0x%02X, 0x%02X, %d);"
+                 % (name, name, name, first, last, y_advance))
+    return lines
+
+
+def generate(libdeps_dir, include_dir):
+    lines = [
+        "// Generated by scripts/font_subsets.py - do not edit.",
+        "",
+        "#pragma once",
+        "",
+        "#include <M5GFX.h>",
+        "",
+        "namespace %s {" % NAMESPACE,
+    ]
+
+    saved = 0
+    for name, chars in SUBSETS.items():
+        lines.append("")
+        text = find_font_source(libdeps_dir, name)
+        if text is None:
+            raise SystemExit("Font subsets: source of %s not found below %s - are the libraries installed?"
+                             % (name, libdeps_dir))
+
+        try:
+            bitmap, glyphs, first, last, y_advance = parse_font(text, name)
+            sub_bitmap, sub_glyphs, sub_first, sub_last = subset_font(bitmap, glyphs, first, last, chars)
+        except ValueError as error:
+            raise SystemExit("Font subsets: source of %s not understood - %s" % (name, error))
+        lines += format_font(name, sub_bitmap, sub_glyphs, sub_first, sub_last, y_advance, chars)
+
+        full_size = len(bitmap) + len(glyphs) * GLYPH_SIZE
+        sub_size = len(sub_bitmap) + len(sub_glyphs) * GLYPH_SIZE
+        saved += full_size - sub_size
+        print("Font %s: %d bytes as subset instead of %d - saves %d bytes of flash"
+              % (name, sub_size, full_size, full_size - sub_size))
+    print("Font subsets save %d bytes of flash in total" % saved)
+
+    lines += ["", "} // namespace %s" % NAMESPACE, ""]
+
+    write_if_changed(os.path.join(include_dir, HEADER_NAME), "\n".join(lines))
+
+
+def write_if_changed(path, text):
+    # Keeps the timestamp and with it the build cache if nothing changed.
+    if os.path.exists(path):
+        with open(path) as f:
+            if f.read() == text:
+                return
+    with open(path, "w") as f:
+        f.write(text)
+
+
+try:
+    Import("env")
+    generate(os.path.join(env.subst("$PROJECT_LIBDEPS_DIR"), env.subst("$PIOENV")),
+             env.subst("$PROJECT_INCLUDE_DIR"))
+except NameError:
+    project_dir = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    generate(sys.argv[1] if len(sys.argv) > 1 else os.path.join(project_dir, ".pio", "libdeps", "m5stack-atoms3"),
+             os.path.join(project_dir, "include"))
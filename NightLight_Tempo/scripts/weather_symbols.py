@@ -0,0 +1,222 @@
+# Project: NightLight
+# Copyright: (c) 2025 Framework Labs
+
+# Converts the embedded WMO weather symbol PNGs into palette-indexed, run-length encoded
+# bitmaps which the device can blit directly - see include/RleBitmap.h for the format.
+#
+# The bitmaps go into a bundle in the data directory which is flashed to the LittleFS
+# partition with `pio run -t uploadfs`, so firmware builds do not carry them.
+#
+# Bundle layout (little endian):
+#   header:  "WSYM", u8 version, u8 symbol count, u16 reserved
+#   index:   per WMO code u32 offset and u16 length of its record - codes may share a record
+#   records: u8 width, u8 height, u8 palette size, u8 reserved, u16 palette[palette size], runs
+#
+# The decoded pixels also go into a reference dump in the build directory - per WMO code u8 width,
+# u8 height and the RGB565 pixels as u16 - against which test_icon_decode checks the device decoder.
+#
+# Runs as a PlatformIO pre script but can also be called directly:
+#   python3 scripts/weather_symbols.py
+
+import glob
+import os
+import re
+import struct
+import zlib
+
+SYMBOL_COUNT = 100
+SOURCE_PATTERN = "WeatherSymbol_WMO_PresentWeather_ww_*.h"
+BUNDLE_NAME = "weather_symbols.bin"
+REFERENCE_NAME = "weather_symbols_ref.bin"
+BUNDLE_MAGIC = b"WSYM"
+BUNDLE_VERSION = 1
+
+MAX_PALETTE_SIZE = 64
+MAX_SHORT_RUN = 3
+MAX_LONG_RUN = 255 + MAX_SHORT_RUN + 1
+
+
+def read_header_bytes(path):
+    with open(path) as f:
+        text = f.read()
+    body = text[text.index("{") + 1:text.index("}")]
+    return bytes(int(byte, 16) for byte in re.findall(r"0x[0-9a-fA-F]{2}", body))
+
+
+def decode_png(data):
+    """Returns width, height and rows of RGBA bytes of a non-interlaced 8 bit RGBA PNG."""
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError("not a PNG")
+
+    pos = 8
+    idat = b""
+    width = height = 0
+    while pos < len(data):
+        length, = struct.unpack(">I", data[pos:pos + 4])
+        kind = data[pos + 4:pos + 8]
+        chunk = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            width, height, depth, color_type, _, _, interlace = struct.unpack(">IIBBBBB", chunk)
+            if depth != 8 or color_type != 6 or interlace != 0:
+                raise ValueError("only non-interlaced 8 bit RGBA is supported")
+        elif kind == b"IDAT":
+            idat += chunk
+        elif kind == b"IEND":
+            break
+
+    raw = zlib.decompress(idat)
+    bpp = 4
+    stride = width * bpp
+    rows = []
+    prev = bytearray(stride)
+    pos = 0
+    for _ in range(height):
+        kind = raw[pos]
+        row = bytearray(raw[pos + 1:pos + 1 + stride])
+        pos += 1 + stride
+        for x in range(stride):
+            a = row[x - bpp] if x >= bpp else 0
+            b = prev[x]
+            c = prev[x - bpp] if x >= bpp else 0
+            if kind == 1:
+                row[x] = (row[x] + a) & 0xff
+            elif kind == 2:
+                row[x] = (row[x] + b) & 0xff
+            elif kind == 3:
+                row[x] = (row[x] + ((a + b) >> 1)) & 0xff
+            elif kind == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                row[x] = (row[x] + (a if pa <= pb and pa <= pc else b if pb <= pc else c)) & 0xff
+        rows.append(row)
+        prev = row
+    return width, height, rows
+
+
+def to_rgb565_on_white(width, rows):
+    """The symbols are only ever shown on white, so alpha is resolved at build time."""
+    pixels = []
+    for row in rows:
+        for x in range(width):
+            r, g, b, a = row[x * 4:x * 4 + 4]
+            r, g, b = ((v * a + 255 * (255 - a) + 127) // 255 for v in (r, g, b))
+            pixels.append(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3))
+    return pixels
+
+
+def encode_rle(pixels):
+    palette = sorted(set(pixels))
+    if len(palette) > MAX_PALETTE_SIZE:
+        raise ValueError("more than %d colors" % MAX_PALETTE_SIZE)
+    index = {color: i for i, color in enumerate(palette)}
+
+    runs = bytearray()
+    pos = 0
+    while pos < len(pixels):
+        end = pos
+        while end < len(pixels) and pixels[end] == pixels[pos] and end - pos < MAX_LONG_RUN:
+            end += 1
+        length = end - pos
+        if length <= MAX_SHORT_RUN:
+            runs.append(index[pixels[pos]] << 2 | (length - 1))
+        else:
+            runs.append(index[pixels[pos]] << 2 | 3)
+            runs.append(length - MAX_SHORT_RUN - 1)
+        pos = end
+    return palette, bytes(runs)
+
+
+def decoded_size(runs):
+    size = 0
+    pos = 0
+    while pos < len(runs):
+        length = (runs[pos] & 3) + 1
+        if length == MAX_SHORT_RUN + 1:
+            pos += 1
+            length = runs[pos] + MAX_SHORT_RUN + 1
+        size += length
+        pos += 1
+    return size
+
+
+def convert(include_dir, data_dir, build_dir):
+    sources = {}
+    for path in glob.glob(os.path.join(include_dir, SOURCE_PATTERN)):
+        code = int(re.search(r"_ww_(\d+)\.h$", path).group(1))
+        sources[code] = path
+
+    if 0 not in sources:
+        raise SystemExit("Weather symbols: the fallback symbol for code 0 is missing")
+
+    # Pixel-identical symbols are only stored once.
+    assets = []  # (width, height, palette, runs)
+    asset_ids = {}
+    symbol_ids = []
+    references = []
+    png_bytes = 0
+    for code in range(SYMBOL_COUNT):
+        if code not in sources:
+            print("Warning: weather symbol %02d is missing - showing symbol 00 instead" % code)
+            symbol_ids.append(symbol_ids[0])
+            references.append(references[0])
+            continue
+
+        data = read_header_bytes(sources[code])
+        png_bytes += len(data)
+        width, height, rows = decode_png(data)
+        pixels = to_rgb565_on_white(width, rows)
+        references.append(struct.pack("<BB%dH" % len(pixels), width, height, *pixels))
+        palette, runs = encode_rle(pixels)
+        if decoded_size(runs) != width * height:
+            raise SystemExit("Weather symbols: symbol %02d does not encode to %dx%d pixels" % (code, width, height))
+
+        asset = (width, height, tuple(palette), runs)
+        asset_id = asset_ids.setdefault(asset, len(assets))
+        if asset_id == len(assets):
+            assets.append(asset)
+        symbol_ids.append(asset_id)
+
+    records = []
+    for width, height, palette, runs in assets:
+        records.append(struct.pack("<BBBB%dH" % len(palette), width, height, len(palette), 0, *palette) + runs)
+
+    header_size = 8 + 6 * SYMBOL_COUNT
+    offsets = []
+    offset = header_size
+    for record in records:
+        offsets.append(offset)
+        offset += len(record)
+
+    bundle = bytearray(BUNDLE_MAGIC + struct.pack("<BBH", BUNDLE_VERSION, SYMBOL_COUNT, 0))
+    for asset_id in symbol_ids:
+        bundle += struct.pack("<IH", offsets[asset_id], len(records[asset_id]))
+    for record in records:
+        bundle += record
+
+    os.makedirs(data_dir, exist_ok=True)
+    write_if_changed(os.path.join(data_dir, BUNDLE_NAME), bytes(bundle))
+    os.makedirs(build_dir, exist_ok=True)
+    write_if_changed(os.path.join(build_dir, REFERENCE_NAME), b"".join(references))
+
+    print("Weather symbols: %d bytes as PNG, %d bytes as RLE bundle (%d of %d symbols unique)" 
+          % (png_bytes, len(bundle), len(assets), SYMBOL_COUNT))
+
+
+def write_if_changed(path, data):
+    # Keeps the timestamp and with it the build cache if nothing changed.
+    if os.path.exists(path):
+        with open(path, "rb") as f:
+            if f.read() == data:
+                return
+    with open(path, "wb") as f:
+        f.write(data)
+
+
+try:
+    Import("env")
+    convert(os.path.join(env.subst("$PROJECT_DIR"), "include"), env.subst("$PROJECT_DATA_DIR"), env.subst("$BUILD_DIR"))
+except NameError:
+    project_dir = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    convert(os.path.join(project_dir, "include"), os.path.join(project_dir, "data"),
+            os.path.join(project_dir, ".pio", "build", "native"))
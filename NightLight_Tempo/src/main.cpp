@@ -1,21 +1,33 @@
 // Project: NightLight
 // Copyright: (c) 2025 Framework Labs
 
-#include "WeatherSymbols.h"
+#include "FontSubsets.h" // Generated by scripts/font_subsets.py.
+#include "ClockGeometry.h"
+#include "DirtyRegion.h"
+#include "GlyphCells.h"
+#include "IoWorker.h"
+#include "RleBitmap.h"
+#include "SecondBoundary.h"
+#include "SpinnerGeometry.h"
+#include "SymbolBundle.h"
+#include "TripleBuffer.h"
+#include "WeatherData.h"
+#include "WeatherRefreshPolicy.h"
 
 #include <proto_activities.h>
 #include <pa_ard_utils.h>
 
 #include <M5Unified.h>
-#include <ArduinoJson.hpp>
 
 #include <Wire.h>
 #include <WiFi.h>
 #include <HTTPClient.h>
+#include <WiFiClientSecure.h>
 #include <Preferences.h>
+#include <LittleFS.h>
 
-#include <esp_pthread.h>
-#include <pthread.h>
+#include <memory>
+#include <type_traits>
 
 using namespace proto_activities::ard_utils;
 
@@ -25,62 +37,297 @@ pa_activity (DelayS, pa_ctx_tm(), int s) {
     pa_delay_s (s);
 } pa_end
 
-pa_activity (RaisingEdgeDetector, pa_ctx(bool prevVal), bool val, bool& edge) {
-    pa_self.prevVal = val;
-    edge = val;
-    pa_pause;
+// I/O Worker
 
-    pa_always {
-        if (val != pa_self.prevVal) {
-            pa_self.prevVal = val;
-            edge = val;
-        } else {
-            edge = false;
-        }
-    } pa_always_end
-} pa_end
+static IoWorker ioWorker;
 
 // Screen
 
+// Screens draw into the back canvas while the front one is still transferred to the LCD via DMA.
 class Dpy {
 public:
+    static constexpr int WIDTH = 128;
+    static constexpr int HEIGHT = 128;
+
     void init(uint8_t brightness = 10) {
         M5.Lcd.setRotation(2);
-        dpy_.createSprite(128, 128);
+        front_->createSprite(WIDTH, HEIGHT);
+        back_->createSprite(WIDTH, HEIGHT);
+
+        // Ending a write transaction waits for pending DMA, so keep one open for good.
+        M5.Lcd.startWrite();
     }
 
     M5Canvas& operator()() {
-        return dpy_;
+        return *back_;
+    }
+
+    // Screens with only a few colors use a smaller canvas - it gets expanded to RGB565 on the way to the LCD.
+    // The expansion runs on the CPU, so pushing such a canvas blocks until the transfer is done instead of running
+    // it via DMA in the background.
+    // Changing the depth loses the canvas contents, so the caller has to draw the whole screen afterwards.
+    // Returns false if there is not enough memory for the new depth - the canvases keep the old one then.
+    bool setColorDepth(lgfx::color_depth_t depth) {
+        const auto previous = back_->getColorDepth();
+        if (previous == depth) {
+            return true;
+        }
+
+        // The front canvas may still be in transfer.
+        M5.Lcd.waitDMA();
+
+        bool didRecreate = true;
+        for (auto* canvas : {front_, back_}) {
+            didRecreate = recreate(*canvas, depth) && didRecreate;
+        }
+        if (!didRecreate) {
+            for (auto* canvas : {front_, back_}) {
+                recreate(*canvas, previous);
+            }
+        }
+        setNeedsDisplay();
+        return didRecreate;
     }
 
+    // Screens can also be drawn ahead of time into a spare canvas which later replaces the back canvas at once.
+    // Between begin and end dpy() refers to the spare canvas - only call it right after displayIfNeeded().
+    // Returns false without beginning if there is not enough memory for the spare canvas.
+    bool beginPrerender(lgfx::color_depth_t depth) {
+        if (!spare_->getBuffer() || spare_->getColorDepth() != depth) {
+            if (!recreate(*spare_, depth)) {
+                return false;
+            }
+        }
+        std::swap(back_, spare_);
+        return true;
+    }
+
+    // Gives back the memory of the spare canvas while no screen draws ahead of time - beginPrerender() creates it again.
+    void releaseSpare() {
+        spare_->deleteSprite();
+    }
+
+    void endPrerender() {
+        dirty_.clear(); // Nothing of it is meant for the LCD yet.
+        std::swap(back_, spare_);
+    }
+
+    // Shows what got drawn between the last begin and end - the previous back canvas becomes the spare one.
+    // Returns false if there is not enough memory to bring the front canvas to the depth of the prerendered one -
+    // the caller has to draw the screen anew then.
+    bool presentPrerendered() {
+        if (!spare_->getBuffer()) {
+            return false;
+        }
+        const auto depth = spare_->getColorDepth();
+        if (front_->getColorDepth() != depth) {
+            // The front canvas may still be in transfer.
+            M5.Lcd.waitDMA();
+            if (!recreate(*front_, depth)) {
+                return false;
+            }
+        }
+        std::swap(back_, spare_);
+        setNeedsDisplay();
+        return true;
+    }
+
+    // Marks the whole screen as dirty.
     void setNeedsDisplay() {
-        needsDisplay_ = true;
+        dirty_.add(bounds());
+    }
+
+    // Marks only the given region as dirty - the caller guarantees that the rest of the canvas is unchanged.
+    void setNeedsDisplay(const Rect& rect) {
+        dirty_.add(rect.clipped(bounds()));
     }
 
     void displayIfNeeded() {
-        if (needsDisplay_) {
-            dpy_.pushSprite(0, 0);
-            needsDisplay_ = false;
+        if (dirty_.isEmpty()) {
+            lastDisplayUs_ = 0;
+            return;
+        }
+
+        const auto start = micros();
+
+        // The previous transfer reads from what becomes the back canvas now - it is long done at our frame rates though.
+        M5.Lcd.waitDMA();
+
+        std::swap(front_, back_);
+
+        // The image push honors the clip rect of the LCD and only transfers the clipped area.
+        for (const auto& rect : dirty_) {
+            M5.Lcd.setClipRect(rect.x, rect.y, rect.w, rect.h);
+            pushDMA(*front_);
+        }
+        M5.Lcd.clearClipRect();
+
+        // Bring the back canvas up to date, so screens can keep drawing incrementally.
+        for (const auto& rect : dirty_) {
+            copyRegion(*front_, *back_, rect);
+        }
+        dirty_.clear();
+
+        lastDisplayUs_ = micros() - start;
+    }
+
+    // How long the last displayIfNeeded() blocked the caller.
+    uint32_t lastDisplayUs() const {
+        return lastDisplayUs_;
+    }
+
+    // The memory of the front, back and spare canvas - 16 KB each in RGB332 and 32 KB in RGB565, none for a released
+    // spare canvas.
+    size_t bufferBytes() const {
+        return canvasA_.bufferLength() + canvasB_.bufferLength() + canvasC_.bufferLength();
+    }
+
+private:
+    static Rect bounds() {
+        return {0, 0, WIDTH, HEIGHT};
+    }
+
+    // Falls back to the previous depth if there is not enough memory for the new one - having freed the old buffer
+    // first, that one fits again unless the heap changed in between.
+    static bool recreate(M5Canvas& canvas, lgfx::color_depth_t depth) {
+        const auto previous = canvas.getColorDepth();
+        canvas.deleteSprite();
+        canvas.setColorDepth(depth);
+        if (canvas.createSprite(WIDTH, HEIGHT)) {
+            return true;
+        }
+        Serial.printf("no memory for a canvas of depth %d\n", static_cast<int>(depth));
+        canvas.setColorDepth(previous);
+        canvas.createSprite(WIDTH, HEIGHT);
+        return false;
+    }
+
+    static void pushDMA(const M5Canvas& canvas) {
+        if (!canvas.getBuffer()) {
+            return;
+        }
+        if (canvas.getColorDepth() == lgfx::rgb332_1Byte) {
+            M5.Lcd.pushImageDMA(0, 0, WIDTH, HEIGHT, static_cast<const lgfx::rgb332_t*>(canvas.getBuffer()));
+        } else {
+            M5.Lcd.pushImageDMA(0, 0, WIDTH, HEIGHT, static_cast<const lgfx::swap565_t*>(canvas.getBuffer()));
+        }
+    }
+
+    static void copyRegion(const M5Canvas& from, M5Canvas& to, const Rect& rect) {
+        if (!from.getBuffer() || !to.getBuffer() || from.bufferLength() != to.bufferLength()) {
+            return;
+        }
+        const size_t bytesPerPixel = from.bufferLength() / (WIDTH * HEIGHT);
+        const size_t stride = WIDTH * bytesPerPixel;
+        const size_t offset = rect.y * stride + rect.x * bytesPerPixel;
+        const auto* src = static_cast<const uint8_t*>(from.getBuffer()) + offset;
+        auto* dst = static_cast<uint8_t*>(to.getBuffer()) + offset;
+        for (int y = 0; y < rect.h; ++y, src += stride, dst += stride) {
+            memcpy(dst, src, rect.w * bytesPerPixel);
         }
     }
 
 private:
-    M5Canvas dpy_{&M5.Lcd};
-    bool needsDisplay_ = false;
+    M5Canvas canvasA_{&M5.Lcd};
+    M5Canvas canvasB_{&M5.Lcd};
+    M5Canvas canvasC_{&M5.Lcd};
+    M5Canvas* front_ = &canvasA_;
+    M5Canvas* back_ = &canvasB_;
+    M5Canvas* spare_ = &canvasC_;
+    DirtyRegion dirty_;
+    uint32_t lastDisplayUs_ = 0;
 };
 
 static Dpy dpy;
 
-pa_activity (DisplayUpdater, pa_ctx()) {
-    pa_always {
-        dpy.displayIfNeeded();
-    } pa_always_end
-} pa_end
+enum class LayerId {
+    clockFace,
+    temperature,
+    percipitation
+};
 
-pa_activity (ScreenWakeup, pa_ctx()) {
-    M5.Display.wakeup();
-    pa_pause; // This is not really needed.
-} pa_end
+// A pre-rendered static background which frames start from instead of clearing and redrawing it.
+// As only one screen is visible at a time, all screens share one layer which remembers whose background it holds.
+// Without memory for the layer the background gets drawn straight into the display canvas on every frame instead.
+class Layer {
+public:
+    // While bypassed the background gets drawn straight into the display canvas too and the layer keeps what it
+    // holds - for screens drawn ahead of time, which would otherwise take the layer from the shown screen.
+    void setBypassed(bool isBypassed) {
+        isBypassed_ = isBypassed;
+    }
+
+    // Returns true if the layer has to be drawn anew for the given id and variant - e.g. the day of a clock face.
+    bool update(LayerId id, int variant = 0) {
+        if (isBypassed_) {
+            return true;
+        }
+        const auto depth = dpy().getColorDepth();
+        if (!layer_.getBuffer() || layer_.getColorDepth() != depth) {
+            layer_.deleteSprite();
+            layer_.setColorDepth(depth);
+            layer_.createSprite(Dpy::WIDTH, Dpy::HEIGHT);
+            isValid_ = false;
+        }
+        if (!layer_.getBuffer()) {
+            return true;
+        }
+
+        if (isValid_ && id == id_ && variant == variant_) {
+            return false;
+        }
+        isValid_ = true;
+        id_ = id;
+        variant_ = variant;
+        return true;
+    }
+
+    M5Canvas& operator()() {
+        return isDrawnDirectly() ? dpy() : layer_;
+    }
+
+    // Copies the whole layer to the display canvas.
+    void blit() {
+        if (isDrawnDirectly() || !dpy().getBuffer()) {
+            return;
+        }
+        memcpy(dpy().getBuffer(), layer_.getBuffer(), layer_.bufferLength());
+    }
+
+    // Copies only the given region of the layer to the display canvas.
+    void restore(const Rect& rect) {
+        if (isDrawnDirectly()) {
+            return;
+        }
+        dpy().setClipRect(rect.x, rect.y, rect.w, rect.h);
+        layer_.pushSprite(&dpy(), 0, 0);
+        dpy().clearClipRect();
+    }
+
+    // Gives back the memory while no screen has a static background - update() creates it again.
+    void release() {
+        layer_.deleteSprite();
+        isValid_ = false;
+    }
+
+    size_t bufferBytes() const {
+        return layer_.bufferLength();
+    }
+
+private:
+    bool isDrawnDirectly() const {
+        return isBypassed_ || !layer_.getBuffer();
+    }
+
+private:
+    M5Canvas layer_;
+    bool isBypassed_ = false;
+    bool isValid_ = false;
+    LayerId id_{};
+    int variant_ = 0;
+};
+
+static Layer background;
 
 // Input Receiver
 
@@ -186,6 +433,34 @@ struct Alarm : BaseAlarm {
     bool dirty = false;
 };
 
+
+// View Model
+
+enum class ScreenId {
+    wait,
+    digitalClock,
+    analogClock,
+    sweepingClock,
+    settings,
+    temperature,
+    percipitation,
+    off
+};
+
+// What the screen shows - the activities fill it in during a tick and the render task draws it.
+struct ViewModel {
+    ScreenId screen{};
+    bool hasTime{};
+    struct tm time{};
+    BaseAlarm alarm{};
+    WeatherData weather{};
+    int weatherAge{}; // In minutes - see WeatherCache::staleMinutes().
+};
+
+static ViewModel view;
+
+// Preferences
+
 class Prefs {
 public:
     void init() {
@@ -228,495 +503,1405 @@ public:
             preferences_.putBool("ClockType", isAnalog);
         }
     }
+
+    bool readIsSweepingClock() {
+        if (!hasLoadedIsSweepingClock_) {
+            loadedIsSweepingClock_ = preferences_.getBool("ClockSweep");
+            hasLoadedIsSweepingClock_ = true;
+        }
+        return loadedIsSweepingClock_;
+    }
+
+    void writeIsSweepingClock(bool isSweeping) {
+        if (!hasLoadedIsSweepingClock_ || isSweeping != loadedIsSweepingClock_) {
+            loadedIsSweepingClock_ = isSweeping;
+            hasLoadedIsSweepingClock_ = true;
+            preferences_.putBool("ClockSweep", isSweeping);
+        }
+    }
+
+    // The last good weather survives a reboot, so the weather can be shown before the network is up.
+    bool readWeather(WeatherData& weather, time_t& fetchedAt) {
+        StoredWeather stored{};
+        if (preferences_.getBytes("Weather", &stored, sizeof(stored)) != sizeof(stored) || !stored.weather.isValid) {
+            return false;
+        }
+        weather = stored.weather;
+        fetchedAt = stored.fetchedAt;
+        return true;
+    }
+
+    // Every hourly refresh gets written - only successes shortly after another one are dropped to spare the flash.
+    void writeWeather(const WeatherData& weather, time_t fetchedAt) {
+        if (hasWrittenWeather_ && fetchedAt - weatherWrittenAt_ < WEATHER_WRITE_INTERVAL_S) {
+            return;
+        }
+        StoredWeather stored{};
+        stored.weather = weather;
+        stored.fetchedAt = fetchedAt;
+        preferences_.putBytes("Weather", &stored, sizeof(stored));
+        weatherWrittenAt_ = fetchedAt;
+        hasWrittenWeather_ = true;
+    }
   
 private:
+    static constexpr time_t WEATHER_WRITE_INTERVAL_S = WeatherRefreshPolicy::PERSIST_INTERVAL_S;
+
+    struct StoredWeather {
+        WeatherData weather;
+        time_t fetchedAt;
+    };
+
     Preferences preferences_;
     Alarm loadedAlarm_;
     bool hasLoadedAlarm_ = false;
     bool loadedIsAnalogClock_ = false;
     bool hasLoadedIsAnalogClock_ = false;
+    bool loadedIsSweepingClock_ = false;
+    bool hasLoadedIsSweepingClock_ = false;
     bool isAlarmDirty_ = false;
+    time_t weatherWrittenAt_ = 0;
+    bool hasWrittenWeather_ = false;
 };
 
 static Prefs prefs;
 
 // Wait screen
 
-static constexpr auto ARC_LEN = 180.0 / 4.0;
-static constexpr auto ARC_INC = 180.0 / 10.0;
+static Rect fillSpinnerArc(float from, float to, int color) {
+    dpy().fillArc(64, 64, ARC_INNER_RADIUS, ARC_OUTER_RADIUS, from, to, color);
+    return arcBounds(from, to);
+}
 
-pa_activity (WaitScreen, pa_ctx(float angle; bool color)) {
-    pa_always {
-        dpy().clear();
+static int spinnerColor(bool color) {
+    return color ? TFT_ORANGE : TFT_GREEN;
+}
+
+// Per frame erases the trailing and draws the leading segment of the arc - see SpinnerStep for how.
+class SpinnerRenderer {
+public:
+    // Forces a full redraw on the next render - e.g. when the screen gets reactivated.
+    void invalidate() {
+        isShown_ = false;
+    }
 
-        dpy().fillArc(64, 64, 20, 30, pa_self.angle, pa_self.angle + ARC_LEN, pa_self.color ? TFT_ORANGE : TFT_GREEN);
+    void render() {
+        if (!isShown_) {
+            dpy().clear();
+            fillSpinnerArc(angle_, angle_ + ARC_LEN, spinnerColor(color_));
+            dpy.setNeedsDisplay(); // Replace whatever the previous screen left behind.
+            isShown_ = true;
+            return;
+        }
 
-        pa_self.angle += ARC_INC;
-        if (pa_self.angle >= 360.0) {
-            pa_self.angle -= 360.0;
-            pa_self.color = !pa_self.color;
+        const SpinnerStep step = spinnerStep(angle_);
+        if (step.isRecolored) {
+            color_ = !color_;
         }
 
-        dpy.setNeedsDisplay();
+        dpy().fillRect(step.erase.x, step.erase.y, step.erase.w, step.erase.h, TFT_BLACK);
+        fillSpinnerArc(step.angle, step.angle + ARC_LEN, spinnerColor(color_));
+
+        angle_ = step.angle;
+        for (const auto& rect : step.damage) {
+            dpy.setNeedsDisplay(rect);
+        }
+    }
+
+private:
+    bool isShown_ = false;
+    float angle_ = 0;
+    bool color_ = false;
+};
+
+static SpinnerRenderer spinner;
+
+pa_activity (WaitScreen, pa_ctx()) {
+    pa_always {
+        view.screen = ScreenId::wait;
     } pa_always_end
 } pa_end
 
 // Clock Screen
 
-static void renderDigitalClock(struct tm& timeinfo) {
+// Keeps the glyph cells of the date and time lines and per second only repaints the cells whose glyph changed.
+class DigitalClockRenderer {
+public:
+    // Forces a full redraw on the next render - e.g. when the screen gets reactivated.
+    void invalidate() {
+        isShown_ = false;
+    }
+
+    void render(const struct tm& timeinfo) {
+        char date[MAX_GLYPHS + 1];
+        char time[MAX_GLYPHS + 1];
+        strftime(date, sizeof(date), "%F", &timeinfo);
+        strftime(time, sizeof(time), "%T", &timeinfo);
+
+        dpy().setFont(&subset_fonts::Roboto_Thin_24);
+
+        if (!isShown_) {
+            dpy().clear();
+            date_ = {};
+            time_ = {};
+        }
+
+        updateLine(date_, date, 0, 20, TFT_PURPLE);
+        updateLine(time_, time, 15, 70, TFT_GOLD);
+
+        if (!isShown_) {
+            dpy.setNeedsDisplay();
+            isShown_ = true;
+        }
+    }
+
+private:
+    static constexpr int MAX_GLYPHS = TextLine::MAX_GLYPHS;
+
+    static int16_t glyphAdvance(char glyph) {
+        lgfx::FontMetrics metrics;
+        dpy().getFont()->getDefaultMetric(&metrics);
+        dpy().getFont()->updateFontMetric(&metrics, glyph);
+        return metrics.x_advance;
+    }
+
+    static void drawGlyph(const TextLine& line, int i, int y) {
+        dpy().setCursor(line.xs[i], y);
+        dpy().print(line.glyphs[i]);
+    }
+
+    void updateLine(TextLine& line, const char* text, int16_t x, int16_t y, int color) {
+        const TextLine next = TextLine::layout(text, x, glyphAdvance);
+        const CellDiff diff = diffCells(line, next, y, dpy().fontHeight());
+        if (diff.damage.isEmpty()) {
+            return;
+        }
+
+        for (int i = 0; i < diff.count; ++i) {
+            if (diff.changed[i]) {
+                const auto& cell = diff.cells[i];
+                dpy().fillRect(cell.x, cell.y, cell.w, cell.h, TFT_BLACK);
+            }
+        }
+
+        dpy().setTextColor(color);
+        for (int i = 0; i < next.len; ++i) {
+            if (diff.needsDraw(i)) {
+                drawGlyph(next, i, y);
+            }
+        }
+
+        dpy.setNeedsDisplay(diff.damage);
+        line = next;
+    }
+
+private:
+    bool isShown_ = false;
+    TextLine date_{};
+    TextLine time_{};
+};
+
+static DigitalClockRenderer digitalClock;
+
+static void drawTick(LovyanGFX& gfx, int s, const ArmOffset (&inner)[60], int color, int thick) {
+    const auto& from = inner[s];
+    const auto& to = ArmTable<63>::offsets[s];
+    gfx.drawLine(64 + from.dx, 64 - from.dy, 64 + to.dx, 64 - to.dy, color);
+}
+
+// Keeps the static face in the background layer and per second only swaps the hands which moved.
+class AnalogClockRenderer {
+public:
+    // Forces a full redraw on the next render - e.g. when the screen gets reactivated.
+    void invalidate() {
+        isShown_ = false;
+    }
+
+    // The fraction of the second lets the second hand sweep instead of tick.
+    void render(const struct tm& timeinfo, float secondFraction = 0) {
+        float positions[HAND_COUNT];
+        handPositions(timeinfo, secondFraction, positions);
+
+        const bool faceChanged = background.update(LayerId::clockFace, timeinfo.tm_mday);
+        if (faceChanged) {
+            renderFace(timeinfo);
+        }
+        if (!isShown_ || faceChanged) {
+            background.blit();
+            drawHands(positions);
+            dpy.setNeedsDisplay();
+            isShown_ = true;
+            return;
+        }
+
+        const Rect damage = handDamage(positions_, positions);
+        if (damage.isEmpty()) {
+            return;
+        }
+
+        // Restore the face under every hand which moved.
+        for (int i = 0; i < HAND_COUNT; ++i) {
+            if (positions[i] != positions_[i]) {
+                background.restore(handBounds(i, positions_[i]));
+            }
+        }
+
+        // Restoring may have cut into hands which did not move, so draw all of them again.
+        drawHands(positions);
+        dpy.setNeedsDisplay(damage);
+    }
+
+private:
+    void renderFace(const struct tm& timeinfo) {
+        auto& face = background();
+
+        face.clear();
+
+        face.setCursor(90, 54);
+        face.setFont(&subset_fonts::Roboto_Thin_24);
+        face.setTextColor(TFT_DARKGRAY);
+        face.println(&timeinfo, "%d");
+
+        face.drawCircle(64, 64, 63, TFT_WHITE);
+
+        for (int s = 0; s < 60; s += 5) {
+            drawTick(face, s, ArmTable<59>::offsets, TFT_WHITE, 1);
+        }
+    }
+
+    void drawHands(const float (&positions)[HAND_COUNT]) {
+        static const int colors[HAND_COUNT] = {TFT_WHITE, TFT_BLUE, TFT_RED};
+
+        for (int i = 0; i < HAND_COUNT; ++i) {
+            const ArmOffset off = handOffset(i, positions[i]);
+            dpy().drawLine(64, 64, 64 + off.dx, 64 - off.dy, colors[i]);
+            positions_[i] = positions[i];
+        }
+    }
+
+private:
+    bool isShown_ = false;
+    float positions_[HAND_COUNT]{};
+};
+
+static AnalogClockRenderer analogClock;
+
+// The sweeping second hand moves between the ticks, so its frames read the clock themselves.
+// While the clock is not set this draws nothing - the next view shows the missing time instead.
+static bool renderSweepingClockFrame() {
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    struct tm timeinfo;
+    localtime_r(&tv.tv_sec, &timeinfo);
+    if (!isClockSet(timeinfo)) {
+        return false;
+    }
+
+    analogClock.render(timeinfo, tv.tv_usec / 1e6f);
+    return true;
+}
+
+static void renderMissingTimeScreen() {
+    dpy().clear();
+    dpy().setCursor(0, 0);
+    dpy().setFont(&fonts::Font0); // The subset fonts lack most letters.
+    dpy().setTextColor(TFT_WHITE);
+    dpy().println("Failed to obtain time");
+    dpy.setNeedsDisplay();
+    digitalClock.invalidate();
+    analogClock.invalidate();
+}
+
+pa_activity (ClockScreen, pa_ctx(SecondBoundary second), bool analog, bool sweep) {
+    pa_self.second.reset();
+
+    pa_always {
+        view.screen = !analog ? ScreenId::digitalClock : sweep ? ScreenId::sweepingClock : ScreenId::analogClock;
+
+        if (pa_self.second.crossed()) {
+            view.hasTime = getLocalTime(&view.time, 50);
+        }
+    } pa_always_end
+} pa_end
+
+pa_activity (ClockScreenController, pa_ctx(pa_use(ClockScreen)), const PressSignal& press) {
+    // Double press cycles digital -> analog -> sweeping analog.
+    pa_repeat {
+        if (prefs.readIsAnalogClock()) {
+            if (!prefs.readIsSweepingClock()) {
+                pa_when_abort (press && press.val() == Press::double_press, ClockScreen, true, false);
+                prefs.writeIsSweepingClock(true);
+            }
+            pa_when_abort (press && press.val() == Press::double_press, ClockScreen, true, true);
+            prefs.writeIsAnalogClock(false);
+            prefs.writeIsSweepingClock(false);
+        }
+        pa_when_abort (press && press.val() == Press::double_press, ClockScreen, false, false);
+        prefs.writeIsAnalogClock(true);
+    }
+} pa_end
+
+// Settings Screen
+
+static uint8_t caw(uint8_t val, int delta, uint8_t limit) {
+    int newVal = val + delta;
+    if (newVal < 0) {
+        return limit + newVal;
+    }
+    if (newVal >= limit) {
+        return newVal - limit;
+    }
+    return newVal;
+}
+
+pa_activity (SettingsController, pa_ctx(), const PressSignal& up, const PressSignal& down, Alarm& alarm) {
+    pa_every (up || down) {
+        if (up && down) {
+            alarm.enabled = !alarm.enabled;
+        } else {
+            const PressSignal& press = up ? up : down;
+            const int inc = up ? +1 : -1;
+
+            if (press.val() == Press::short_press || press.val() == Press::long_press) {
+                alarm.minute = caw(alarm.minute, inc, 60);
+            } else if (press.val() == Press::double_press) {
+                alarm.hour = caw(alarm.hour, inc, 24);
+            }
+        }
+
+        alarm.dirty = true;
+    } pa_every_end
+} pa_end
+
+static void renderSettingsScreen(const BaseAlarm& alarm) {
     dpy().clear();
 
-    dpy().setCursor(0, 20);
-    dpy().setFont(&fonts::Roboto_Thin_24);
-    dpy().setTextColor(TFT_PURPLE);
-    dpy().println(&timeinfo, "%F");  
+    dpy().setCursor(30, 50);
+    dpy().setFont(&subset_fonts::Roboto_Thin_24);
 
-    dpy().setCursor(15, 70);
-    dpy().setFont(&fonts::Roboto_Thin_24);
-    dpy().setTextColor(TFT_GOLD);
-    dpy().println(&timeinfo, "%T");
+    if (alarm.enabled) {
+        dpy().setTextColor(TFT_GREEN);
+    } else {
+        dpy().setTextColor(TFT_RED);
+    }
+
+    dpy().printf("%2d:%02d", alarm.hour, alarm.minute);
 
     dpy.setNeedsDisplay();
 }
 
-static float stophi(int s) {
-    return PI * (15 - s) / 30;
+pa_activity (SettingsPresenter, pa_ctx(), Alarm alarm) {
+    pa_always {
+        view.screen = ScreenId::settings;
+        view.alarm = alarm;
+    } pa_always_end
+} pa_end
+
+pa_activity (SettingsPersister, pa_ctx(), Alarm& alarm) {
+    pa_every (alarm.dirty) {
+        prefs.writeAlarm(alarm);
+        alarm.dirty = false;
+    } pa_every_end
+} pa_end
+
+pa_activity (SettingsTimeout, pa_ctx(pa_use(DelayS)), const PressSignal& up, const PressSignal& down) {
+    pa_when_reset (up || down, DelayS, 4);
+} pa_end
+
+pa_activity (SettingsScreen, pa_ctx(pa_co_res(4); pa_defer_res;
+                                    pa_use(SettingsController); pa_use(SettingsTimeout); pa_use(SettingsPresenter);
+                                    pa_use(SettingsPersister); Alarm alarm), 
+                             const PressSignal& up, const PressSignal& down) {
+    pa_defer {
+        prefs.writeAlarmIfNeeded();
+    };
+
+    pa_self.alarm = prefs.readAlarm();
+
+    pa_co(4) {
+        pa_with_weak (SettingsController, up, down, pa_self.alarm);
+        pa_with_weak (SettingsPresenter, pa_self.alarm);
+        pa_with_weak (SettingsPersister, pa_self.alarm);
+        pa_with (SettingsTimeout, up, down);
+    } pa_co_end
+} pa_end
+
+// Weather Screen
+
+static constexpr bool LOG_WEATHER_TIMINGS = false;
+
+static constexpr const char* WEATHER_HOST = "api.open-meteo.com";
+static constexpr const char* WEATHER_URL = "https://api.open-meteo.com/v1/forecast?latitude=48.1374&longitude=11.5755&current=temperature_2m&daily=temperature_2m_max,temperature_2m_min,weather_code,precipitation_probability_max&timezone=Europe%2FBerlin&forecast_days=1";
+
+class WeatherAccessor : public IoJob {
+public:
+    // Returns false if the fetch could not be queued.
+    bool start() {
+        if (isPending()) {
+            return false;
+        }
+        weather_.isValid = false;
+
+        return ioWorker.post(*this);
+    }
+
+    // Returns a copy - the worker might already write the next result.
+    WeatherData getWeather() {
+        if (results_.fetch()) {
+            weather_ = results_.front();
+        }
+        return weather_;
+    }
+
+private:
+    // The resolved address is kept for an hour and a connection for as long as servers typically keep it open.
+    static constexpr uint32_t DNS_CACHE_MS = 60 * 60 * 1000;
+    static constexpr uint32_t KEEP_ALIVE_MS = 30 * 1000;
+
+    struct Timings {
+        uint32_t dnsUs;
+        uint32_t connectUs;
+        uint32_t requestUs;
+        uint32_t bodyUs;
+        bool isReused;
+    };
+
+    // Only sets up a connection if the one of the previous fetch is gone.
+    bool connect(Timings& timings) {
+        if (client_.connected() && millis() - lastUseMs_ < KEEP_ALIVE_MS) {
+            timings.isReused = true;
+            return true;
+        }
+        client_.stop();
+
+        auto start = micros();
+        if (!isHostResolved_ || millis() - resolvedMs_ >= DNS_CACHE_MS) {
+            if (!WiFi.hostByName(WEATHER_HOST, hostIp_)) {
+                return false;
+            }
+            isHostResolved_ = true;
+            resolvedMs_ = millis();
+        }
+        timings.dnsUs = micros() - start;
+
+        // TCP connect and TLS handshake happen in one call - without a CA like HTTPClient did before.
+        start = micros();
+        client_.setInsecure();
+        if (!client_.connect(hostIp_, 443, WEATHER_HOST, nullptr, nullptr, nullptr)) {
+            isHostResolved_ = false; // The address might have moved.
+            return false;
+        }
+        timings.connectUs = micros() - start;
+        return true;
+    }
+
+    void run() override {
+        http_.useHTTP10(true); // Avoids chunked transfer encoding, so the body can be parsed right from the stream.
+        http_.setReuse(true);  // Keeps the connection open if the server agrees.
+
+        Timings timings{};
+        WeatherData weather{};
+
+        do {
+            if (!connect(timings)) {
+                //Serial.println("connect failed");
+                break;
+            }
+            //Serial.println("http begin...");
+            if (!http_.begin(client_, WEATHER_URL)) {
+                //Serial.println("http begin failed");
+                break;
+            }
+            //Serial.println("http get...");
+            auto start = micros();
+            const auto code = http_.GET();
+            timings.requestUs = micros() - start;
+            if (code != HTTP_CODE_OK) {
+                //Serial.printf("http GET failed with: %d\n", code);
+                client_.stop(); // Do not reuse a connection in an unknown state.
+                break;
+            }
+            start = micros();
+            //Serial.println("json deserialize...");
+            const auto res = parseWeather(http_.getStream(), weather);
+            timings.bodyUs = micros() - start;
+            if (res.code() != ArduinoJson::DeserializationError::Ok) {
+                //Serial.printf("json deserialization failed: %s\n", res.c_str());
+                break;
+            }
+
+        } while (false);
+                
+        //Serial.println("http end...");
+        http_.end();
+        lastUseMs_ = millis();
+
+        //Serial.println("http end...done");
+
+        if (LOG_WEATHER_TIMINGS) {
+            Serial.printf("weather fetch: dns %u us, connect and handshake %u us, request %u us, body %u us%s\n",
+                          timings.dnsUs, timings.connectUs, timings.requestUs, timings.bodyUs,
+                          timings.isReused ? " - reused connection" : "");
+        }
+
+        results_.back() = weather;
+        results_.publish();
+    }
+
+private:
+    TripleBuffer<WeatherData> results_;
+    WeatherData weather_{};
+    WiFiClientSecure client_;
+    HTTPClient http_; // Lives as long as the client - destroying an HTTPClient stops its client and the connection.
+    IPAddress hostIp_;
+    bool isHostResolved_{};
+    uint32_t resolvedMs_{};
+    uint32_t lastUseMs_{};
+};
+
+static WeatherAccessor weatherAccessor;
+
+// Writes the weather to the flash on the I/O worker - an NVS write can stall for tens of milliseconds, which the tick
+// should not. Only the worker touches the weather write state of Prefs, and NVS itself locks around its accesses.
+class WeatherPersister : public IoJob {
+public:
+    // Returns false if the previous write is still pending - the update is skipped then, the next one follows soon.
+    bool persist(const WeatherData& weather, time_t fetchedAt) {
+        if (isPending()) {
+            return false;
+        }
+        weather_ = weather;
+        fetchedAt_ = fetchedAt;
+        return ioWorker.post(*this);
+    }
+
+protected:
+    void run() override {
+        prefs.writeWeather(weather_, fetchedAt_);
+    }
+
+private:
+    WeatherData weather_{};
+    time_t fetchedAt_ = 0;
+};
+
+static WeatherPersister weatherPersister;
+
+// The latest weather, kept fresh by the WeatherProvider in Main whatever screen is shown - so the weather screen
+// has data in its first frame. It is also restored at boot, so even the first frame after a reboot has data.
+class WeatherCache {
+public:
+    // A bit more than the hourly refresh of the WeatherRefreshPolicy - so only a failed refresh makes it stale.
+    static constexpr time_t STALE_S = 90 * 60;
+    static constexpr int UNKNOWN_AGE = -1;
+
+    void restore() {
+        prefs.readWeather(weather_, fetchedAt_);
+    }
+
+    const WeatherData& latest() const {
+        return weather_;
+    }
+
+    void update(const WeatherData& weather) {
+        weather_ = weather;
+        fetchedAt_ = time(nullptr);
+        weatherPersister.persist(weather_, fetchedAt_);
+    }
+
+    // Minutes since the latest weather got fetched once it is stale, 0 before that and
+    // UNKNOWN_AGE while the clock is not set - as after a power loss until NTP is established.
+    int staleMinutes() const {
+        const time_t now = time(nullptr);
+        if (!isClockSet(now) || !isClockSet(fetchedAt_)) {
+            return UNKNOWN_AGE;
+        }
+        const time_t age = now - fetchedAt_;
+        return age < STALE_S ? 0 : static_cast<int>(age / 60);
+    }
+
+private:
+    WeatherData weather_{};
+    time_t fetchedAt_ = 0;
+};
+
+static WeatherCache weatherCache;
+
+static WeatherRefreshPolicy weatherRefresh(random);
+
+pa_activity (WeatherProvider, pa_ctx_tm(uint32_t delayS)) {
+    pa_repeat {
+        // Nobody would see the result - the restored cache and its age cover the time until the screen is on again.
+        pa_await (view.screen != ScreenId::off);
+
+        // Awaits the state rather than a completion signal, which a suspended provider would miss.
+        if (weatherAccessor.start()) {
+            pa_await (!weatherAccessor.isPending());
+        }
+
+        if (weatherAccessor.getWeather().isValid) {
+            weatherCache.update(weatherAccessor.getWeather());
+            pa_self.delayS = weatherRefresh.onSuccess(time(nullptr));
+        } 
+        else {
+            // The cache keeps the old data - better show it than a spinner.
+            pa_self.delayS = weatherRefresh.onFailure();
+        }
+
+        //Serial.printf("Next weather fetch in %u s\n", pa_self.delayS);
+        pa_delay_s (pa_self.delayS);
+    }
+} pa_end
+
+// Marks weather which could not be refreshed for a while - or of unknown age, as restored before NTP got established.
+static void drawWeatherAge(int age) {
+    if (age == 0) {
+        return;
+    }
+    char text[8];
+    if (age == WeatherCache::UNKNOWN_AGE) {
+        strcpy(text, "?");
+    } else if (age < 60) {
+        snprintf(text, sizeof(text), "%dm", age);
+    } else if (age < 48 * 60) {
+        snprintf(text, sizeof(text), "%dh", age / 60);
+    } else {
+        snprintf(text, sizeof(text), "%dd", age / (24 * 60));
+    }
+
+    dpy().setFont(&fonts::Font0); // The subset fonts lack the letters.
+    dpy().setTextColor(TFT_DARKGREY);
+    dpy().setCursor(126 - dpy().textWidth(text), 119);
+    dpy().print(text);
+}
+
+static void renderTemperatureScreen(const WeatherData& weather, int age) {
+    // Where the values continue after their labels.
+    static int16_t maxTempX;
+    static int16_t minTempX;
+
+    if (background.update(LayerId::temperature)) {
+        auto& layer = background();
+
+        layer.fillRect(0, 0, 128, 128, TFT_WHITE);
+
+        layer.setCursor(10, 15);
+        layer.setFont(&subset_fonts::FreeSans12pt7b);
+        layer.setTextColor(TFT_RED);
+        layer.print("max:");
+        maxTempX = layer.getCursorX();
+
+        layer.setCursor(10, 95);
+        layer.setFont(&subset_fonts::FreeSans12pt7b);
+        layer.setTextColor(TFT_BLUE);
+        layer.print("min:");
+        minTempX = layer.getCursorX();
+    }
+    background.blit();
+
+    dpy().setCursor(maxTempX, 15);
+    dpy().setFont(&subset_fonts::FreeSans12pt7b);
+    dpy().setTextColor(TFT_RED);
+    dpy().printf(" % 2.1f", weather.maxTemp);
+
+    dpy().setCursor(30, 50);
+    dpy().setFont(&subset_fonts::FreeSans18pt7b);
+    dpy().setTextColor(TFT_BLACK);
+    dpy().printf("% 2.1f", weather.curTemp);
+
+    dpy().setCursor(minTempX, 95);
+    dpy().setFont(&subset_fonts::FreeSans12pt7b);
+    dpy().setTextColor(TFT_BLUE);
+    dpy().printf(" % 2.1f", weather.minTemp);
+
+    drawWeatherAge(age);
+
+    dpy.setNeedsDisplay();
+}
+
+pa_activity (TemperatureScreen, pa_ctx(), const WeatherData& weather) {
+    pa_always {
+        view.screen = ScreenId::temperature;
+        view.weather = weather;
+        view.weatherAge = weatherCache.staleMinutes();
+    } pa_always_end
+} pa_end
+
+// Draws a bitmap as generated by scripts/weather_symbols.py - returns false if its runs turned out to be malformed.
+static bool drawRleBitmap(LovyanGFX& gfx, const RleBitmap& bitmap, int32_t x, int32_t y) {
+    gfx.startWrite();
+    const bool isComplete = forEachRleSpan(bitmap, [&](int32_t col, int32_t row, int32_t len, uint16_t color) {
+        gfx.writeFastHLine(x + col, y + row, len, color);
+    });
+    gfx.endWrite();
+    return isComplete;
 }
 
-static void drawArmLine(int offx, int offy, int len, float co, float si) {
-    dpy().drawLine(64 + offx, 64 - offy, 64 + offx + len * co, 64 - offy - len * si);
+// The weather symbols rarely change, so they live in a bundle on the LittleFS partition instead of the firmware image.
+// See scripts/weather_symbols.py for the layout - the bundle gets flashed with `pio run -t uploadfs`.
+class WeatherSymbolBundle {
+public:
+    void init() {
+        if (!LittleFS.begin()) {
+            Serial.println("Mounting LittleFS failed - no weather symbols");
+            return;
+        }
+
+        File file = LittleFS.open(PATH, "r");
+        uint8_t header[SymbolBundleIndex::HEADER_SIZE];
+        if (!file || file.read(header, sizeof(header)) != sizeof(header) || !index_.parse(header)) {
+            Serial.println("Weather symbol bundle missing or outdated - run uploadfs");
+            return;
+        }
+        isValid_ = true;
+    }
+
+    // Streams the symbol for the code from the bundle and draws it - unknown codes show the symbol of code 0.
+    bool draw(LovyanGFX& gfx, int weatherCode, int32_t x, int32_t y) {
+        if (!isValid_) {
+            return false;
+        }
+
+        const auto& entry = index_.entryOf(weatherCode);
+        if (entry.length < SymbolBundleIndex::RECORD_HEADER_SIZE) {
+            return false;
+        }
+        std::unique_ptr<uint8_t[]> record{new uint8_t[entry.length]};
+
+        File file = LittleFS.open(PATH, "r");
+        if (!file || !file.seek(entry.offset) || file.read(record.get(), entry.length) != entry.length) {
+            return false;
+        }
+
+        RleBitmap bitmap;
+        if (!SymbolBundleIndex::bitmapOf(record.get(), entry.length, bitmap)) {
+            return false;
+        }
+        return drawRleBitmap(gfx, bitmap, x, y);
+    }
+
+private:
+    static constexpr const char* PATH = "/weather_symbols.bin";
+
+private:
+    SymbolBundleIndex index_;
+    bool isValid_ = false;
+};
+
+static WeatherSymbolBundle weatherSymbols;
+
+static constexpr bool LOG_ICON_CACHE = false;
+
+// Keeps the most recently shown weather symbols decoded, so redrawing one is a plain blit.
+class WeatherIconCache {
+public:
+    static constexpr int ICON_SIZE = 55;
+    static constexpr int CAPACITY = 3;
+
+    void draw(int weatherCode, int32_t x, int32_t y) {
+        auto& entry = lookup(weatherCode);
+        entry.lastUse = ++useCount_;
+
+        const auto start = micros();
+        entry.icon.pushSprite(&dpy(), x, y);
+        if (LOG_ICON_CACHE) {
+            Serial.printf("weather icon %d blitted in %lu us\n", weatherCode, micros() - start);
+        }
+    }
+
+    // Gives back the memory while no weather screen is shown.
+    void release() {
+        for (auto& entry : entries_) {
+            entry.icon.deleteSprite();
+            entry.weatherCode = -1;
+        }
+    }
+
+    size_t bufferBytes() const {
+        size_t bytes = 0;
+        for (const auto& entry : entries_) {
+            bytes += entry.icon.bufferLength();
+        }
+        return bytes;
+    }
+
+private:
+    struct Entry {
+        int weatherCode = -1;
+        uint32_t lastUse = 0;
+        M5Canvas icon;
+    };
+
+    Entry& lookup(int weatherCode) {
+        Entry* lru = &entries_[0];
+        for (auto& entry : entries_) {
+            if (entry.weatherCode == weatherCode) {
+                return entry;
+            }
+            if (entry.lastUse < lru->lastUse) {
+                lru = &entry;
+            }
+        }
+        decode(*lru, weatherCode);
+        return *lru;
+    }
+
+    static void decode(Entry& entry, int weatherCode) {
+        const auto start = micros();
+
+        if (!entry.icon.getBuffer()) {
+            entry.icon.createSprite(ICON_SIZE, ICON_SIZE);
+        }
+
+        // A stale or cut bundle shows the symbol of code 0 instead or, if that is broken too, nothing.
+        if (!weatherSymbols.draw(entry.icon, weatherCode, 0, 0) &&
+            (weatherCode == 0 || !weatherSymbols.draw(entry.icon, 0, 0, 0))) {
+            entry.icon.fillScreen(TFT_WHITE);
+        }
+        entry.weatherCode = weatherCode;
+
+        if (LOG_ICON_CACHE) {
+            Serial.printf("weather icon %d decoded in %lu us\n", weatherCode, micros() - start);
+        }
+    }
+
+private:
+    Entry entries_[CAPACITY];
+    uint32_t useCount_ = 0;
+};
+
+static WeatherIconCache weatherIcons;
+
+static void drawWeatherCode(int weatherCode) {
+    weatherIcons.draw(weatherCode, 36, 10);
 }
 
-static void drawArm(int s, int len, int color, int thick) {
-    const auto phi = stophi(s);
-    const auto co = cosf(phi);
-    const auto si = sinf(phi);
+static void renderPercipitationScreen(const WeatherData& weather, int age) {
+    // Where the values continue after their labels.
+    static int16_t codeX;
+    static int16_t rainX;
 
-    dpy().setColor(color);
-    drawArmLine(0, 0, len, co, si);
-}
+    if (background.update(LayerId::percipitation)) {
+        auto& layer = background();
 
-static void drawTick(int s, int len, int color, int thick) {
-    const auto phi = stophi(s);
-    const auto co = cosf(phi);
-    const auto si = sinf(phi);
-    dpy().drawLine(64 + len * co, 64 - len * si, 64 + 63 * co, 64 - 63 * si, color);
-}
+        layer.fillRect(0, 0, 128, 128, TFT_WHITE);
 
-static void renderAnalogClock(struct tm& timeinfo) {
-    dpy().clear();
+        layer.setCursor(20, 70);
+        layer.setFont(&subset_fonts::FreeSans9pt7b);
+        layer.setTextColor(TFT_BLACK);
+        layer.print("Wetter:");
+        codeX = layer.getCursorX();
 
-    dpy().setCursor(90, 54);
-    dpy().setFont(&fonts::Roboto_Thin_24);
-    dpy().setTextColor(TFT_DARKGRAY);
-    dpy().println(&timeinfo, "%d");
-    
-    dpy().drawCircle(64, 64, 63, TFT_WHITE);
-    
-    for (int s = 0; s < 60; s += 5) {
-        drawTick(s, 59, TFT_WHITE, 1);
+        layer.setCursor(3, 95);
+        layer.setFont(&subset_fonts::FreeSans12pt7b);
+        layer.setTextColor(TFT_BLUE);
+        layer.print("Rain:");
+        rainX = layer.getCursorX();
     }
+    background.blit();
+
+    drawWeatherCode(weather.weatherCode);
+
+    dpy().setCursor(codeX, 70);
+    dpy().setFont(&subset_fonts::FreeSans9pt7b);
+    dpy().setTextColor(TFT_BLACK);
+    dpy().printf(" %d", weather.weatherCode);
 
-    drawArm(timeinfo.tm_hour * 5 + timeinfo.tm_min / 12, 40, TFT_WHITE, 3);
-    drawArm(timeinfo.tm_min, 58, TFT_BLUE, 2);
-    drawArm(timeinfo.tm_sec, 62, TFT_RED, 1);
+    dpy().setCursor(rainX, 95);
+    dpy().setFont(&subset_fonts::FreeSans12pt7b);
+    dpy().setTextColor(TFT_BLUE);
+    dpy().printf(" %3d%%", weather.maxPercipitationProb);
+
+    drawWeatherAge(age);
 
     dpy.setNeedsDisplay();
 }
 
-pa_activity (ClockScreen, pa_ctx_tm(pa_use(ScreenWakeup)), bool analog) {
-    pa_run (ScreenWakeup);
-
-    pa_every_s (1) {
-        struct tm timeinfo;
-        if (!getLocalTime(&timeinfo, 50)) {
-            dpy().clear();
-            dpy().println("Failed to obtain time");
-            dpy.setNeedsDisplay();
-        } 
-        else {
-            if (analog) {
-                renderAnalogClock(timeinfo);
-            } else {
-                renderDigitalClock(timeinfo);
-            }
-        }
-    } pa_every_end
+pa_activity (PercipitationScreen, pa_ctx(), const WeatherData& weather) {
+    pa_always {
+        view.screen = ScreenId::percipitation;
+        view.weather = weather;
+        view.weatherAge = weatherCache.staleMinutes();
+    } pa_always_end
 } pa_end
 
-pa_activity (ClockScreenController, pa_ctx(pa_use(ClockScreen)), const PressSignal& press) {
+pa_activity (WeatherOrWaitScreenController, pa_ctx(pa_use(TemperatureScreen); pa_use(PercipitationScreen); pa_use(WaitScreen)), 
+                                            const WeatherData& weather, const PressSignal& press) {
     pa_repeat {
-        if (prefs.readIsAnalogClock()) {
-            pa_when_abort (press && press.val() == Press::double_press, ClockScreen, true);
-            prefs.writeIsAnalogClock(false);
+        if (!weather.isValid) {
+            pa_when_abort (weather.isValid, WaitScreen);
+        }
+        pa_when_abort (!weather.isValid || (press && press.val() == Press::double_press), TemperatureScreen, weather);
+        if (weather.isValid) {
+            pa_when_abort (!weather.isValid || (press && press.val() == Press::double_press), PercipitationScreen, weather);
         }
-        pa_when_abort (press && press.val() == Press::double_press, ClockScreen, false);
-        prefs.writeIsAnalogClock(true);
     }
 } pa_end
 
-// Settings Screen
-
-static uint8_t caw(uint8_t val, int delta, uint8_t limit) {
-    int newVal = val + delta;
-    if (newVal < 0) {
-        return limit + newVal;
-    }
-    if (newVal >= limit) {
-        return newVal - limit;
-    }
-    return newVal;
-}
-
-pa_activity (SettingsController, pa_ctx(), const PressSignal& up, const PressSignal& down, Alarm& alarm) {
-    pa_every (up || down) {
-        if (up && down) {
-            alarm.enabled = !alarm.enabled;
-        } else {
-            const PressSignal& press = up ? up : down;
-            const int inc = up ? +1 : -1;
-
-            if (press.val() == Press::short_press || press.val() == Press::long_press) {
-                alarm.minute = caw(alarm.minute, inc, 60);
-            } else if (press.val() == Press::double_press) {
-                alarm.hour = caw(alarm.hour, inc, 24);
-            }
-        }
-
-        alarm.dirty = true;
-    } pa_every_end
+pa_activity (WeatherScreenController, pa_ctx(pa_use(WeatherOrWaitScreenController)), const PressSignal& press) {
+    pa_run (WeatherOrWaitScreenController, weatherCache.latest(), press);
 } pa_end
 
-pa_activity (SettingsPresenter, pa_ctx(), Alarm alarm) {
-    pa_repeat {
-        dpy().clear();
-
-        dpy().setCursor(30, 50);
-        dpy().setFont(&fonts::Roboto_Thin_24);
+// Off Screen
 
-        if (alarm.enabled) {
-            dpy().setTextColor(TFT_GREEN);
-        } else {
-            dpy().setTextColor(TFT_RED);
-        }
+pa_activity (OffScreenController, pa_ctx()) {
+    pa_always {
+        view.screen = ScreenId::off;
+    } pa_always_end
+} pa_end
 
-        dpy().printf("%2d:%02d", alarm.hour, alarm.minute);
+// Render Task
 
-        dpy.setNeedsDisplay();
+static constexpr bool LOG_RENDER_STATS = false;
+static constexpr bool LOG_BOOT_TIMING = false;
 
-        pa_await (alarm.dirty);
+class RenderStats {
+public:
+    void add(uint32_t frameUs, uint32_t displayUs) {
+        ++frames_;
+        totalFrameUs_ += frameUs;
+        maxFrameUs_ = std::max(maxFrameUs_, frameUs);
+        maxDisplayUs_ = std::max(maxDisplayUs_, displayUs);
     }
-} pa_end
-
-pa_activity (SettingsPersister, pa_ctx(), Alarm& alarm) {
-    pa_every (alarm.dirty) {
-        prefs.writeAlarm(alarm);
-        alarm.dirty = false;
-    } pa_every_end
-} pa_end
 
-pa_activity (SettingsTimeout, pa_ctx(pa_use(DelayS)), const PressSignal& up, const PressSignal& down) {
-    pa_when_reset (up || down, DelayS, 4);
-} pa_end
+    // Returns true if it logged.
+    bool logEvery(uint32_t ms) {
+        const uint32_t elapsedUs = micros() - startUs_;
+        if (elapsedUs < ms * 1000) {
+            return false;
+        }
+        if (frames_ > 0) {
+            Serial.printf("render: %.1f fps - frame avg: %u us max: %u us - display max: %u us - cpu: %.1f %%\n",
+                          frames_ * 1e6f / elapsedUs, totalFrameUs_ / frames_, maxFrameUs_, maxDisplayUs_,
+                          totalFrameUs_ * 100.0f / elapsedUs);
+        }
+        *this = {};
+        startUs_ = micros();
+        return true;
+    }
 
-pa_activity (SettingsScreen, pa_ctx(pa_co_res(4); pa_defer_res;
-                                    pa_use(ScreenWakeup); 
-                                    pa_use(SettingsController); pa_use(SettingsTimeout); pa_use(SettingsPresenter);
-                                    pa_use(SettingsPersister); Alarm alarm), 
-                             const PressSignal& up, const PressSignal& down) {
-    pa_defer {
-        prefs.writeAlarmIfNeeded();
-    };
+private:
+    uint32_t startUs_ = 0;
+    uint32_t frames_ = 0;
+    uint32_t totalFrameUs_ = 0;
+    uint32_t maxFrameUs_ = 0;
+    uint32_t maxDisplayUs_ = 0;
+};
 
-    pa_run (ScreenWakeup);
+// FNV-1a over what a screen gets drawn from - compound types are hashed member-wise, so padding does not matter.
+static uint32_t hashBytes(uint32_t hash, const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
 
-    pa_self.alarm = prefs.readAlarm();
+template <typename T>
+static uint32_t hashValue(uint32_t hash, const T& value) {
+    static_assert(std::is_arithmetic<T>::value, "Add a member-wise hashValue overload for compound types");
+    return hashBytes(hash, &value, sizeof(value));
+}
 
-    pa_co(4) {
-        pa_with_weak (SettingsController, up, down, pa_self.alarm);
-        pa_with_weak (SettingsPresenter, pa_self.alarm);
-        pa_with_weak (SettingsPersister, pa_self.alarm);
-        pa_with (SettingsTimeout, up, down);
-    } pa_co_end
-} pa_end
+static uint32_t hashValue(uint32_t hash, const struct tm& time) {
+    for (int field : {time.tm_sec, time.tm_min, time.tm_hour, time.tm_mday, time.tm_mon, time.tm_year}) {
+        hash = hashValue(hash, field);
+    }
+    return hash;
+}
 
-// Weather Screen
+static uint32_t hashValue(uint32_t hash, const BaseAlarm& alarm) {
+    hash = hashValue(hash, alarm.enabled);
+    hash = hashValue(hash, alarm.hour);
+    return hashValue(hash, alarm.minute);
+}
 
-struct WeatherData {
-    bool isValid{};
-    float curTemp{};
-    float minTemp{};
-    float maxTemp{};
-    int weatherCode{};
-    int maxPercipitationProb{};
+static uint32_t hashValue(uint32_t hash, const WeatherData& weather) {
+    hash = hashValue(hash, weather.isValid);
+    hash = hashValue(hash, weather.curTemp);
+    hash = hashValue(hash, weather.minTemp);
+    hash = hashValue(hash, weather.maxTemp);
+    hash = hashValue(hash, weather.weatherCode);
+    return hashValue(hash, weather.maxPercipitationProb);
+}
 
-    bool operator==(const WeatherData& other) const {
-        return isValid == other.isValid 
-            && curTemp == other.curTemp
-            && minTemp == other.minTemp
-            && maxTemp == other.maxTemp
-            && weatherCode == other.weatherCode
-            && maxPercipitationProb == other.maxPercipitationProb;      
-    }
+static uint32_t hashValues(uint32_t hash) {
+    return hash;
+}
 
-    bool operator!=(const WeatherData& other) const { return !(*this == other); }
-};
+template <typename T, typename... Rest>
+static uint32_t hashValues(uint32_t hash, const T& value, const Rest&... rest) {
+    return hashValues(hashValue(hash, value), rest...);
+}
 
-class WeatherAccessor {
+// Remembers the hash of the inputs a screen was last drawn from, so a frame with the same inputs is neither
+// rasterized nor pushed to the LCD.
+class RenderMemo {
 public:
-    WeatherAccessor() {
-    }
+    static constexpr uint32_t FNV_OFFSET = 2166136261u;
 
-    ~WeatherAccessor() {
-        stop();
+    // Forces the next frame to render - e.g. when the screen gets entered and the canvas holds something else.
+    void invalidate() {
+        isValid_ = false;
     }
 
-    void init() {
-        if (didInit_) {
-            return;
-        }
-        esp_pthread_init();
-
-        esp_pthread_cfg_t cfg = esp_pthread_get_default_config();
-        cfg.stack_size = 1024 * 8;
-        cfg.prio = 1;
-        cfg.pin_to_core = 1;
-        esp_pthread_set_cfg(&cfg);
-        didInit_ = true;
+    template <typename... Inputs>
+    bool matches(const Inputs&... inputs) const {
+        return isValid_ && hashValues(FNV_OFFSET, inputs...) == hash_;
     }
 
-    void start() {
-        if (isRunning_) {
-            return;
+    template <typename... Inputs>
+    bool needsRender(const Inputs&... inputs) {
+        const uint32_t hash = hashValues(FNV_OFFSET, inputs...);
+        if (isValid_ && hash == hash_) {
+            ++skipped_;
+            return false;
         }
+        isValid_ = true;
+        hash_ = hash;
+        ++performed_;
+        return true;
+    }
 
-        isRunning_ = true;
-        isDone_ = false;
-        weather_.isValid = false;
+    uint32_t performed() const {
+        return performed_;
+    }
 
-        //Serial.println("starting thread..."); //Serial.flush();
-        init();
-        pthread_create(&thread_, nullptr, staticRunner, this);
-        //Serial.println("starting thread...done");
+    uint32_t skipped() const {
+        return skipped_;
     }
 
-    void stop() {
-        if (thread_) {
-            pthread_join(thread_, nullptr);
-            thread_ = {};
-        }
+    void resetCounts() {
+        performed_ = 0;
+        skipped_ = 0;
     }
 
-    bool isDone() const {
-        return isDone_;
+private:
+    bool isValid_ = false;
+    uint32_t hash_ = 0;
+    uint32_t performed_ = 0;
+    uint32_t skipped_ = 0;
+};
+
+// Draws the published view model on core 0, so the activities on core 1 only decide what to show and their tick
+// stays short however long rasterizing and the LCD transfer take. All access to the LCD happens on this task.
+class Renderer {
+public:
+    static constexpr uint32_t SWEEP_FRAME_MS = 33;
+
+    void init() {
+        xTaskCreatePinnedToCore(staticRunner, "Renderer", 8192, this, 1, &task_, 0);
     }
 
-    const WeatherData& getWeather() const {
-        assert (isDone_);
-        return weather_;
+    // Called once per tick - never blocks.
+    void publish(const ViewModel& view) {
+        auto& published = views_.back();
+        published.view = view;
+        published.us = micros();
+        views_.publish();
+        xTaskNotifyGive(task_);
     }
 
 private:
-    static void* staticRunner(void* self) {
-        reinterpret_cast<WeatherAccessor*>(self)->runner();
-        return nullptr;
+    static void staticRunner(void* self) {
+        reinterpret_cast<Renderer*>(self)->runner();
     }
 
     void runner() {
-        HTTPClient http;
+        dpy.init();
 
-        do {
-            //Serial.println("http begin...");
-            if (!http.begin("https://api.open-meteo.com/v1/forecast?latitude=48.1374&longitude=11.5755&current=temperature_2m&daily=temperature_2m_max,temperature_2m_min,weather_code,precipitation_probability_max&timezone=Europe%2FBerlin&forecast_days=1")) {
-                //Serial.println("http begin failed");
-                break;
+        TickType_t nextSweepFrame = 0;
+
+        while (true) {
+            TickType_t timeout = portMAX_DELAY;
+            if (isSweeping()) {
+                const TickType_t now = xTaskGetTickCount();
+                timeout = int32_t(nextSweepFrame - now) > 0 ? nextSweepFrame - now : 0;
             }
-            //Serial.println("http get...");
-            const auto code = http.GET();
-            if (code != HTTP_CODE_OK) {
-                //Serial.printf("http GET failed with: %d\n", code);
-                break;
+            ulTaskNotifyTake(pdTRUE, timeout);
+
+            const uint32_t start = micros();
+            bool didSwitch = false;
+
+            if (views_.fetch()) {
+                const bool wasSweeping = isSweeping();
+                didSwitch = isShown_ && views_.front().view.screen != shown_.screen;
+                render(views_.front().view);
+                if (!wasSweeping) {
+                    nextSweepFrame = xTaskGetTickCount();
+                }
             }
-            //Serial.println("printing payload...");
-            const auto payload = http.getString();
-            //Serial.println(payload);
-
-            ArduinoJson::DynamicJsonDocument doc(1024);
-
-            //Serial.println("json deserialize...");
-            const auto res = ArduinoJson::deserializeJson(doc, payload);
-            if (res.code() != ArduinoJson::DeserializationError::Ok) {
-                //Serial.printf("json deserialization failed: %s\n", res.c_str());
-                break;
+            if (isSweeping()) {
+                const TickType_t now = xTaskGetTickCount();
+                if (int32_t(now - nextSweepFrame) >= 0) {
+                    if (!renderSweepingClockFrame()) {
+                        // Stops sweeping until a view with the time arrives.
+                        shown_.hasTime = false;
+                    }
+                    nextSweepFrame = now + pdMS_TO_TICKS(SWEEP_FRAME_MS);
+                }
+            }
+            dpy.displayIfNeeded();
+
+            if (LOG_RENDER_STATS) {
+                stats_.add(micros() - start, dpy.lastDisplayUs());
+                if (didSwitch) {
+                    // From the tick which switched the screen until its pixels are on the LCD.
+                    M5.Lcd.waitDMA();
+                    Serial.printf("switch to %s: %lu us%s\n", screenName(shown_.screen), micros() - views_.front().us,
+                                  didPresentPrerendered_ ? " (prerendered)" : "");
+                }
+                if (stats_.logEvery(10 * 1000)) {
+                    logMemos();
+                    logMemory();
+                }
+            }
+            didPresentPrerendered_ = false;
+
+            if (!didShowUsefulFrame_ && isShown_ && shown_.screen != ScreenId::wait && shown_.screen != ScreenId::off) {
+                didShowUsefulFrame_ = true;
+                if (LOG_BOOT_TIMING) {
+                    M5.Lcd.waitDMA();
+                    Serial.printf("boot: first useful frame (%s) after %lu ms\n", screenName(shown_.screen), millis());
+                }
             }
 
-            weather_.maxTemp = doc["daily"]["temperature_2m_max"][0].as<float>();
-            weather_.curTemp = doc["current"]["temperature_2m"].as<float>();
-            weather_.minTemp = doc["daily"]["temperature_2m_min"][0].as<float>();
-            weather_.weatherCode = doc["daily"]["weather_code"][0].as<int>();
-            weather_.maxPercipitationProb = doc["daily"]["precipitation_probability_max"][0].as<int>();
-            weather_.isValid = true;
-
-        } while (false);
-                
-        //Serial.println("http end...");
-        http.end();
-
-        //Serial.println("http end...done");
-
-        isDone_ = true;
-        isRunning_ = false;
+            prerenderAlternateWeatherScreen();
+        }
     }
 
-private:
-    bool didInit_{};
-    std::atomic_bool isRunning_{};
-    std::atomic_bool isDone_{};
-    pthread_t thread_{};
-    WeatherData weather_{};
-};
+    bool isSweeping() const {
+        return isShown_ && shown_.screen == ScreenId::sweepingClock && shown_.hasTime;
+    }
 
-static WeatherAccessor weatherAccessor;
-static WeatherData cachedWeather;
+    void render(const ViewModel& view) {
+        const bool isEntering = !isShown_ || view.screen != shown_.screen;
+        if (isEntering) {
+            enter(view);
+        }
 
-pa_activity (WeatherProvider, pa_ctx_tm(int tries), WeatherData& weather) {
-    pa_repeat {
-        weather.isValid = false;
-        pa_self.tries = 0;
+        switch (view.screen) {
+            case ScreenId::wait:
+                spinner.render();
+                break;
 
-        pa_repeat {
-            ++pa_self.tries;
+            case ScreenId::digitalClock:
+            case ScreenId::analogClock:
+            case ScreenId::sweepingClock:
+                // The sweeping clock only shows a missing time here - its frames are timed by the runner.
+                if (memo(view.screen).needsRender(view.hasTime, view.time)) {
+                    if (!view.hasTime) {
+                        renderMissingTimeScreen();
+                    } else if (view.screen == ScreenId::digitalClock) {
+                        digitalClock.render(view.time);
+                    } else if (view.screen == ScreenId::analogClock) {
+                        analogClock.render(view.time);
+                    }
+                }
+                break;
 
-            weatherAccessor.start();
-            pa_await (weatherAccessor.isDone());
+            case ScreenId::settings:
+                if (memo(view.screen).needsRender(view.alarm)) {
+                    renderSettingsScreen(view.alarm);
+                }
+                break;
 
-            if (weatherAccessor.getWeather().isValid) {
+            case ScreenId::temperature:
+            case ScreenId::percipitation:
+                if (memo(view.screen).needsRender(view.weather, view.weatherAge)) {
+                    renderWeatherScreen(view.screen, view.weather, view.weatherAge);
+                }
                 break;
-            }
-            if (pa_self.tries == 5) {
+
+            case ScreenId::off:
                 break;
-            }
-            //Serial.println("Failed loading weather - retrying in 2 seconds");
-            pa_delay_s (2); // retry every 2 seconds
         }
 
-        if (weatherAccessor.getWeather().isValid) {
-            cachedWeather = weatherAccessor.getWeather();
-            weather = weatherAccessor.getWeather();
-
-            //Serial.println("Succeeded retrieving weather - refreshing in 15 min");
-            pa_delay_m (15); // update every 15 minutes in case of success
-        } 
-        else {
-            weather = cachedWeather; // Better show old data than a spinner for 1 min.
+        shown_ = view;
+        isShown_ = true;
+    }
 
-            //Serial.println("Failed retrieving weather - retrying in 1 min");
-            pa_delay_m (1); // retry every minute in case of error
+    void enter(const ViewModel& view) {
+        const auto screen = view.screen;
+        releaseUnusedBuffers(screen);
+        if (screen == ScreenId::off) {
+            dpy().clear();
+            dpy.setNeedsDisplay();
+            dpy.displayIfNeeded();
+            M5.Lcd.waitDMA();
+            M5.Display.sleep();
+            return;
+        }
+        if (isShown_ && shown_.screen == ScreenId::off) {
+            M5.Display.wakeup();
         }
-    }
-} pa_end
 
-pa_activity (TemperatureScreen, pa_ctx(WeatherData prevWeather), bool sigActivation, const WeatherData& weather) {
-    pa_repeat {
-        dpy().fillRect(0, 0, 128, 128, TFT_WHITE);
+        memo(screen).invalidate();
+        spinner.invalidate();
+        digitalClock.invalidate();
+        analogClock.invalidate();
 
-        dpy().setCursor(10, 15);
-        dpy().setFont(&fonts::FreeSans12pt7b);
-        dpy().setTextColor(TFT_RED);
-        dpy().printf("max: % 2.1f", weather.maxTemp);
+        if (screen == prerenderedScreen_ && prerendered_.matches(view.weather, view.weatherAge) && presentPrerendered()) {
+            memo(screen).needsRender(view.weather, view.weatherAge);
+        } else {
+            dpy.setColorDepth(colorDepthOf(screen));
+        }
+    }
 
-        dpy().setCursor(30, 50);
-        dpy().setFont(&fonts::FreeSans18pt7b);
-        dpy().setTextColor(TFT_BLACK);
-        dpy().printf("% 2.1f", weather.curTemp);
+    // A canvas takes 32 KB in RGB565 and 16 KB in RGB332. The panel takes RGB565 either way, so the bytes on the SPI
+    // bus stay the same - RGB332 only saves RAM and costs the DMA running in the background, as the CPU expands the
+    // pixels while pushing. With only the dirty rects pushed per frame that is a few hundred pixels though, so only
+    // the weather symbols get full color.
+    static lgfx::color_depth_t colorDepthOf(ScreenId screen) {
+        return screen == ScreenId::percipitation ? lgfx::rgb565_2Byte : lgfx::rgb332_1Byte;
+    }
 
-        dpy().setCursor(10, 95);
-        dpy().setFont(&fonts::FreeSans12pt7b);
-        dpy().setTextColor(TFT_BLUE);
-        dpy().printf("min: % 2.1f", weather.minTemp);
+    static bool isWeatherScreen(ScreenId screen) {
+        return screen == ScreenId::temperature || screen == ScreenId::percipitation;
+    }
 
-        dpy.setNeedsDisplay();
+    // Only the weather screens draw ahead of time and show symbols, only they and the analog clocks have a static
+    // background - the other screens get along with the front and back canvas, 32 KB in all.
+    void releaseUnusedBuffers(ScreenId screen) {
+        if (!isWeatherScreen(screen)) {
+            dpy.releaseSpare();
+            weatherIcons.release();
+            prerendered_.invalidate();
+            prerenderedScreen_ = ScreenId::off;
+        }
+        if (!isWeatherScreen(screen) && screen != ScreenId::analogClock && screen != ScreenId::sweepingClock) {
+            background.release();
+        }
+    }
 
-        pa_self.prevWeather = weather;
-        pa_await (weather != pa_self.prevWeather || sigActivation);
+    static void renderWeatherScreen(ScreenId screen, const WeatherData& weather, int age) {
+        if (screen == ScreenId::temperature) {
+            renderTemperatureScreen(weather, age);
+        } else {
+            renderPercipitationScreen(weather, age);
+        }
     }
-} pa_end
 
-static void drawWeatherCode(int weatherCode) {
-    size_t weatherSymbolSize;
-    const uint8_t* weatherSymbol = getWeatherSymbol(weatherCode, weatherSymbolSize);
+    // While a weather screen is shown, the other one gets drawn into the spare canvas, so switching between them
+    // only swaps canvases instead of rasterizing - and decoding a weather symbol - after the press.
+    void prerenderAlternateWeatherScreen() {
+        if (!isShown_ || !shown_.weather.isValid) {
+            return;
+        }
+        ScreenId alternate;
+        if (shown_.screen == ScreenId::temperature) {
+            alternate = ScreenId::percipitation;
+        } else if (shown_.screen == ScreenId::percipitation) {
+            alternate = ScreenId::temperature;
+        } else {
+            return;
+        }
 
-    dpy().drawPng(weatherSymbol, weatherSymbolSize, 36, 10);
-}
+        if (prerenderedScreen_ != alternate) {
+            prerendered_.invalidate();
+            prerenderedScreen_ = alternate;
+        }
+        if (!prerendered_.needsRender(shown_.weather, shown_.weatherAge)) {
+            return;
+        }
 
-pa_activity (PercipitationScreen, pa_ctx(WeatherData prevWeather), bool sigActivation, const WeatherData& weather) {
-    pa_repeat {
-        dpy().fillRect(0, 0, 128, 128, TFT_WHITE);
+        if (!dpy.beginPrerender(colorDepthOf(alternate))) {
+            prerendered_.invalidate();
+            return;
+        }
+        background.setBypassed(true);
+        renderWeatherScreen(alternate, shown_.weather, shown_.weatherAge);
+        background.setBypassed(false);
+        dpy.endPrerender();
+    }
 
-        drawWeatherCode(weather.weatherCode);
+    // Must happen before the color depth gets changed, as the canvas of the screen we leave becomes the spare one.
+    bool presentPrerendered() {
+        if (!dpy.presentPrerendered()) {
+            prerendered_.invalidate();
+            return false;
+        }
+        didPresentPrerendered_ = true;
 
-        dpy().setCursor(20, 70);
-        dpy().setFont(&fonts::FreeSans9pt7b);
-        dpy().setTextColor(TFT_BLACK);
-        dpy().printf("Wetter: %d", weather.weatherCode);
+        // The spare canvas now holds the screen we left - which is the alternate one again.
+        prerendered_.invalidate();
+        if (isWeatherScreen(shown_.screen)) {
+            prerenderedScreen_ = shown_.screen;
+            prerendered_.needsRender(shown_.weather, shown_.weatherAge);
+        }
+        return true;
+    }
 
-        dpy().setCursor(3, 95);
-        dpy().setFont(&fonts::FreeSans12pt7b);
-        dpy().setTextColor(TFT_BLUE);
-        dpy().printf("Rain: %3d%%", weather.maxPercipitationProb);
+    RenderMemo& memo(ScreenId screen) {
+        return memos_[static_cast<int>(screen)];
+    }
 
-        dpy.setNeedsDisplay();
+    static const char* screenName(ScreenId screen) {
+        static const char* const names[SCREEN_COUNT] = {
+            "wait", "digital", "analog", "sweeping", "settings", "temperature", "percipitation", "off"
+        };
+        return names[static_cast<int>(screen)];
+    }
 
-        pa_self.prevWeather = weather;
-        pa_await (weather != pa_self.prevWeather || sigActivation);
+    // The minimum of the free heap includes the peak of the TLS handshake of the weather fetch.
+    static void logMemory() {
+        Serial.printf("memory: canvases %u B, layer %u B, icons %u B - free heap %u B, min %u B, largest block %u B\n",
+                      dpy.bufferBytes(), background.bufferBytes(), weatherIcons.bufferBytes(), ESP.getFreeHeap(),
+                      ESP.getMinFreeHeap(), ESP.getMaxAllocHeap());
     }
-} pa_end
 
-pa_activity (WeatherOrWaitScreenController, pa_ctx(pa_use(TemperatureScreen); pa_use(PercipitationScreen); pa_use(WaitScreen)), 
-                                            bool sigActivation, const WeatherData& weather, const PressSignal& press) {
-    pa_repeat {
-        if (!weather.isValid) {
-            pa_when_abort (weather.isValid, WaitScreen);
-        }
-        pa_when_abort (!weather.isValid || (press && press.val() == Press::double_press), TemperatureScreen, sigActivation, weather);
-        if (weather.isValid) {
-            pa_when_abort (!weather.isValid || (press && press.val() == Press::double_press), PercipitationScreen, sigActivation, weather);
+    void logMemos() {
+        for (int i = 0; i < SCREEN_COUNT; ++i) {
+            auto& memo = memos_[i];
+            if (memo.performed() > 0 || memo.skipped() > 0) {
+                Serial.printf("memo %s: rendered %u skipped %u\n", screenName(static_cast<ScreenId>(i)),
+                              memo.performed(), memo.skipped());
+            }
+            memo.resetCounts();
         }
     }
-} pa_end
 
-pa_activity (WeatherScreenController, pa_ctx(pa_co_res(2); WeatherData weather;
-                                             pa_use(WeatherProvider); pa_use(WeatherOrWaitScreenController)), 
-                                      bool sigActivation, const PressSignal& press) {
-    pa_co(2) {
-        pa_with (WeatherProvider, pa_self.weather)
-        pa_with (WeatherOrWaitScreenController, sigActivation, pa_self.weather, press);
-    } pa_co_end
-} pa_end
+private:
+    static constexpr int SCREEN_COUNT = static_cast<int>(ScreenId::off) + 1;
 
-// Off Screen
+    struct PublishedView {
+        ViewModel view;
+        uint32_t us;
+    };
 
-pa_activity (OffScreenController, pa_ctx()) {
-    dpy().clear();
-    dpy.setNeedsDisplay();
+    TaskHandle_t task_{};
+    TripleBuffer<PublishedView> views_;
+    ViewModel shown_{};
+    bool isShown_ = false;
+    RenderMemo memos_[SCREEN_COUNT];
+    RenderMemo prerendered_;
+    ScreenId prerenderedScreen_ = ScreenId::off;
+    bool didPresentPrerendered_ = false;
+    bool didShowUsefulFrame_ = false;
+    RenderStats stats_;
+};
 
-    M5.Display.sleep();
-    pa_halt;
+static Renderer renderer;
+
+pa_activity (ViewPublisher, pa_ctx()) {
+    pa_always {
+        renderer.publish(view);
+    } pa_always_end
 } pa_end
 
 // UI
 
-pa_activity (GadgetScreenController, pa_ctx(pa_use(ClockScreenController); pa_use(WeatherScreenController)), bool sigActivation, bool isBuzzing, const PressSignal& press) {
+pa_activity (GadgetScreenController, pa_ctx(pa_use(ClockScreenController); pa_use(WeatherScreenController)), bool isBuzzing, const PressSignal& press) {
     pa_repeat {
         pa_when_abort (press && press.val() == Press::long_press, ClockScreenController, press);
         pa_await_immediate (!press);
-        pa_when_abort ((press && press.val() == Press::long_press) || isBuzzing, WeatherScreenController, sigActivation, press);
+        pa_when_abort ((press && press.val() == Press::long_press) || isBuzzing, WeatherScreenController, press);
         pa_await_immediate (!press);
     }
 } pa_end
 
-pa_activity (SuspendingGadgetScreenController, pa_ctx(pa_use(GadgetScreenController)), bool isActive, bool sigActivation, bool isBuzzing, const PressSignal& press) {
-    pa_when_suspend (!isActive, GadgetScreenController, sigActivation, isBuzzing, press);
+pa_activity (SuspendingGadgetScreenController, pa_ctx(pa_use(GadgetScreenController)), bool isActive, bool isBuzzing, const PressSignal& press) {
+    pa_when_suspend (!isActive, GadgetScreenController, isBuzzing, press);
 } pa_end
 
 pa_activity (SettingsScreenController, pa_ctx(pa_use(SettingsScreen)), const PressSignal& up, const PressSignal& down, bool isBuzzing, bool& showSettings) {
@@ -727,14 +1912,12 @@ pa_activity (SettingsScreenController, pa_ctx(pa_use(SettingsScreen)), const Pre
     } pa_every_end
 } pa_end
 
-pa_activity (OnScreenController, pa_ctx(pa_co_res(3); pa_use(SettingsScreenController); 
-                                        pa_use(SuspendingGadgetScreenController); pa_use(RaisingEdgeDetector);
-                                        bool showSettings; bool sigActivation), 
+pa_activity (OnScreenController, pa_ctx(pa_co_res(2); pa_use(SettingsScreenController); 
+                                        pa_use(SuspendingGadgetScreenController); bool showSettings), 
                                  const PressSignal& press, const PressSignal& up, const PressSignal& down, bool isBuzzing) {
-    pa_co(3) {
+    pa_co(2) {
         pa_with (SettingsScreenController, up, down, isBuzzing, pa_self.showSettings);
-        pa_with (RaisingEdgeDetector, !pa_self.showSettings, pa_self.sigActivation);
-        pa_with (SuspendingGadgetScreenController, !pa_self.showSettings, pa_self.sigActivation, isBuzzing, press);
+        pa_with (SuspendingGadgetScreenController, !pa_self.showSettings, isBuzzing, press);
     } pa_co_end
 } pa_end
 
@@ -910,31 +2093,74 @@ pa_activity (PressToneGenerator, pa_ctx_tm(pa_use(ShortToneMaker); pa_use(Double
 
 // Main
 
-pa_activity (Main, pa_ctx(pa_co_res(8); pa_signal_res;
-                          pa_use(WiFiAndNTPConnector); pa_use(WiFiConnectionMaintainer); pa_use(PressRecognizer); 
+// Shows the weather restored from before the reboot while connecting - the spinner only if there is none.
+pa_activity (BootScreen, pa_ctx(pa_use(TemperatureScreen); pa_use(WaitScreen))) {
+    if (weatherCache.latest().isValid) {
+        pa_run (TemperatureScreen, weatherCache.latest());
+    } else {
+        pa_run (WaitScreen);
+    }
+} pa_end
+
+pa_activity (Main, pa_ctx(pa_co_res(9); pa_signal_res;
+                          pa_use(WiFiAndNTPConnector); pa_use(WiFiConnectionMaintainer); pa_use(WeatherProvider);
+                          pa_use(PressRecognizer); 
                           pa_use(AudioManager); pa_use(PressToneGenerator);
-                          pa_use(UI); pa_use(Buzzer); pa_use(DisplayUpdater); pa_use(WaitScreen); pa_use(InputReceiver);
+                          pa_use(UI); pa_use(Buzzer); pa_use(ViewPublisher); pa_use(BootScreen); pa_use(InputReceiver);
                           pa_def_val_signal(Press, press); pa_def_val_signal(Press, up); pa_def_val_signal(Press, down);
                           bool isBuzzing; bool audioEnabled; int audioRequests),
                    bool didOverrun) {
     pa_co (3) {
         pa_with (WiFiAndNTPConnector);
-        pa_with_weak (WaitScreen);
-        pa_with_weak (DisplayUpdater);
+        pa_with_weak (BootScreen);
+        pa_with_weak (ViewPublisher);
     } pa_co_end
 
-    pa_co(8) {
+    pa_co(9) {
         pa_with (WiFiConnectionMaintainer);
+        pa_with (WeatherProvider);
         pa_with (PressRecognizer, 41, pa_self.press);
         pa_with (InputReceiver, pa_self.press, pa_self.up, pa_self.down);
         pa_with (PressToneGenerator, pa_self.press, pa_self.audioEnabled, pa_self.audioRequests);
         pa_with (Buzzer, pa_self.press, pa_self.up, pa_self.down, pa_self.audioEnabled, pa_self.audioRequests, pa_self.isBuzzing);
         pa_with (UI, pa_self.press, pa_self.up, pa_self.down, pa_self.isBuzzing);
         pa_with (AudioManager, pa_self.audioRequests, pa_self.audioEnabled);
-        pa_with (DisplayUpdater);
+        pa_with (ViewPublisher);
     } pa_co_end
 } pa_end
 
+// Tick Statistics
+
+static constexpr bool LOG_TICK_STATS = false;
+
+class TickStats {
+public:
+    void add(uint32_t tickUs, bool didOverrun) {
+        ++ticks_;
+        totalTickUs_ += tickUs;
+        maxTickUs_ = std::max(maxTickUs_, tickUs);
+        if (didOverrun) {
+            ++overruns_;
+        }
+    }
+
+    void logEvery(uint32_t ticks) {
+        if (ticks_ < ticks) {
+            return;
+        }
+        Serial.printf("tick avg: %u us max: %u us - overruns: %u/%u\n", totalTickUs_ / ticks_, maxTickUs_, overruns_, ticks_);
+        *this = {};
+    }
+
+private:
+    uint32_t ticks_ = 0;
+    uint32_t overruns_ = 0;
+    uint32_t totalTickUs_ = 0;
+    uint32_t maxTickUs_ = 0;
+};
+
+static TickStats tickStats;
+
 // Setup and Loop
 
 static pa_use(Main);
@@ -946,8 +2172,11 @@ void setup() {
     auto config = M5.config();
     M5.begin(config);
 
-    dpy.init();
     prefs.init();
+    weatherCache.restore();
+    ioWorker.init();
+    weatherSymbols.init();
+    renderer.init();
 }
 
 void loop() {
@@ -955,15 +2184,26 @@ void loop() {
     bool wasDelayed = false;
 
     while (true) {
+        const uint32_t start = micros();
+
         M5.update();
 
+        ioWorker.deliverCompletions();
+
         pa_tick(Main, !wasDelayed);
 
+        const uint32_t tickUs = micros() - start;
+
         // We run at 10 Hz.
         wasDelayed = xTaskDelayUntil(&prevWakeTime, 100);
 
         if (!wasDelayed) {
             //Serial.println("DID OVERRUN");
         }
+
+        if (LOG_TICK_STATS) {
+            tickStats.add(tickUs, !wasDelayed);
+            tickStats.logEvery(100);
+        }
     }
 }
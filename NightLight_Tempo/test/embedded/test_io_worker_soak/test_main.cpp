@@ -0,0 +1,81 @@
+// Project: NightLight
+// Copyright: (c) 2025 Framework Labs
+
+#include "IoWorker.h"
+
+#include <unity.h>
+
+#include <memory>
+
+// Runs on the device, as the worker is a FreeRTOS task: pio test -e m5stack-atoms3
+
+static IoWorker worker;
+
+// Allocates and frees on the worker like a weather fetch does with its connection and response.
+class SoakJob : public IoJob {
+public:
+    int runs = 0;
+
+protected:
+    void run() override {
+        std::unique_ptr<char[]> response(new char[2048]);
+        snprintf(response.get(), 2048, "{\"run\":%d}", runs);
+        ++runs;
+    }
+};
+
+// Posts the job and delivers completions until it is done - like the WeatherProvider does tick by tick.
+static void cycle(SoakJob& job, int count) {
+    for (int i = 0; i < count; ++i) {
+        TEST_ASSERT_TRUE(worker.post(job));
+        while (job.isPending()) {
+            delay(1);
+            worker.deliverCompletions();
+        }
+    }
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_pending_job_is_not_posted_again() {
+    SoakJob job;
+    TEST_ASSERT_TRUE(worker.post(job));
+    TEST_ASSERT_FALSE(worker.post(job));
+    while (job.isPending()) {
+        delay(1);
+        worker.deliverCompletions();
+    }
+    TEST_ASSERT_EQUAL(1, job.runs);
+}
+
+static void test_thousands_of_cycles_keep_memory_flat() {
+    constexpr int CYCLES = 5000;
+
+    SoakJob job;
+    cycle(job, 100); // Whatever gets allocated lazily on first use.
+    const uint32_t freeHeap = ESP.getFreeHeap();
+
+    cycle(job, CYCLES);
+
+    char text[96];
+    snprintf(text, sizeof(text), "%d cycles: free heap %u B before, %u B after, min %u B", CYCLES, freeHeap,
+             ESP.getFreeHeap(), ESP.getMinFreeHeap());
+    TEST_MESSAGE(text);
+
+    TEST_ASSERT_EQUAL(100 + CYCLES, job.runs);
+    // A thread per fetch would have lost its stack each cycle - the worker must not lose a byte per cycle.
+    TEST_ASSERT_UINT32_WITHIN(CYCLES / 10, freeHeap, ESP.getFreeHeap());
+}
+
+void setup() {
+    delay(2000); // Lets the serial monitor of the test runner connect.
+    worker.init();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_pending_job_is_not_posted_again);
+    RUN_TEST(test_thousands_of_cycles_keep_memory_flat);
+    UNITY_END();
+}
+
+void loop() {}
@@ -0,0 +1,103 @@
+// Project: NightLight
+// Copyright: (c) 2025 Framework Labs
+
+#include "ClockGeometry.h"
+
+#include <unity.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+// As the float path of the analog clock computed the offsets before the tables.
+static ArmOffset floatOffset(float s, int len) {
+    const float phi = CLOCK_PI * (15 - s) / 30;
+    return {int8_t(lroundf(len * cosf(phi))), int8_t(lroundf(len * sinf(phi)))};
+}
+
+template <int LEN>
+static int maxDeviation() {
+    int deviation = 0;
+    for (int s = 0; s < 60; ++s) {
+        const ArmOffset expected = floatOffset(s, LEN);
+        const ArmOffset& actual = ArmTable<LEN>::offsets[s];
+        deviation = std::max(deviation, std::abs(actual.dx - expected.dx));
+        deviation = std::max(deviation, std::abs(actual.dy - expected.dy));
+    }
+    return deviation;
+}
+
+void setUp() {}
+void tearDown() {}
+
+// Every arm length the analog clock uses: hour, minute and second hand, inner and outer end of the ticks.
+static void test_table_endpoints_match_float_trig_within_one_pixel() {
+    TEST_ASSERT_LESS_OR_EQUAL(1, maxDeviation<40>());
+    TEST_ASSERT_LESS_OR_EQUAL(1, maxDeviation<58>());
+    TEST_ASSERT_LESS_OR_EQUAL(1, maxDeviation<59>());
+    TEST_ASSERT_LESS_OR_EQUAL(1, maxDeviation<62>());
+    TEST_ASSERT_LESS_OR_EQUAL(1, maxDeviation<63>());
+}
+
+static void test_table_is_point_symmetric() {
+    for (int s = 0; s < 30; ++s) {
+        TEST_ASSERT_EQUAL(-ArmTable<62>::offsets[s].dx, ArmTable<62>::offsets[s + 30].dx);
+        TEST_ASSERT_EQUAL(-ArmTable<62>::offsets[s].dy, ArmTable<62>::offsets[s + 30].dy);
+    }
+}
+
+// The offsets of one renderAnalogClock() pass: three hands and the twelve ticks of the face.
+static volatile int sink;
+
+static void test_benchmark_table_against_float_trig() {
+    constexpr int PASSES = 200000;
+    using Clock = std::chrono::steady_clock;
+
+    auto start = Clock::now();
+    for (int pass = 0; pass < PASSES; ++pass) {
+        const int s = pass % 60;
+        int sum = 0;
+        const ArmOffset hands[] = {floatOffset(s, 40), floatOffset(s, 58), floatOffset(s, 62)};
+        for (const auto& hand : hands) {
+            sum += hand.dx + hand.dy;
+        }
+        for (int tick = 0; tick < 60; tick += 5) {
+            const ArmOffset from = floatOffset(tick, 59);
+            const ArmOffset to = floatOffset(tick, 63);
+            sum += from.dx + from.dy + to.dx + to.dy;
+        }
+        sink = sum;
+    }
+    const double floatNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / PASSES;
+
+    start = Clock::now();
+    for (int pass = 0; pass < PASSES; ++pass) {
+        const int s = pass % 60;
+        int sum = 0;
+        const ArmOffset hands[] = {ArmTable<40>::offsets[s], ArmTable<58>::offsets[s], ArmTable<62>::offsets[s]};
+        for (const auto& hand : hands) {
+            sum += hand.dx + hand.dy;
+        }
+        for (int tick = 0; tick < 60; tick += 5) {
+            const ArmOffset& from = ArmTable<59>::offsets[tick];
+            const ArmOffset& to = ArmTable<63>::offsets[tick];
+            sum += from.dx + from.dy + to.dx + to.dy;
+        }
+        sink = sum;
+    }
+    const double tableNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / PASSES;
+
+    char text[96];
+    snprintf(text, sizeof(text), "clock pass offsets: float trig %.1f ns, table %.1f ns", floatNs, tableNs);
+    TEST_MESSAGE(text);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_table_endpoints_match_float_trig_within_one_pixel);
+    RUN_TEST(test_table_is_point_symmetric);
+    RUN_TEST(test_benchmark_table_against_float_trig);
+    return UNITY_END();
+}
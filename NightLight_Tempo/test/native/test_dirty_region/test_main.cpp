@@ -0,0 +1,278 @@
+// Project: NightLight
+// Copyright: (c) 2025 Framework Labs
+
+#include "ClockGeometry.h"
+#include "DirtyRegion.h"
+#include "GlyphCells.h"
+
+#include <unity.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+
+static constexpr int WIDTH = 128;
+static constexpr int HEIGHT = 128;
+static constexpr int FRAME_PIXELS = WIDTH * HEIGHT;
+
+static const Rect SCREEN{0, 0, WIDTH, HEIGHT};
+
+// What Dpy::displayIfNeeded() pushes for the region.
+static int pushedPixels(const DirtyRegion& region) {
+    int pixels = 0;
+    for (const auto& rect : region) {
+        pixels += rect.w * rect.h;
+    }
+    return pixels;
+}
+
+static int rectCount(const DirtyRegion& region) {
+    return region.end() - region.begin();
+}
+
+// Counts every screen pixel once, however the rects overlap.
+static int coveredPixels(const DirtyRegion& region) {
+    int pixels = 0;
+    for (int y = 0; y < HEIGHT; ++y) {
+        for (int x = 0; x < WIDTH; ++x) {
+            for (const auto& rect : region) {
+                if (x >= rect.x && x < rect.right() && y >= rect.y && y < rect.bottom()) {
+                    ++pixels;
+                    break;
+                }
+            }
+        }
+    }
+    return pixels;
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_rect_united_and_clipped() {
+    const Rect a{10, 10, 20, 5};
+    const Rect b{25, 0, 10, 12};
+    const Rect u = a.united(b);
+    TEST_ASSERT_EQUAL(10, u.x);
+    TEST_ASSERT_EQUAL(0, u.y);
+    TEST_ASSERT_EQUAL(25, u.w);
+    TEST_ASSERT_EQUAL(15, u.h);
+
+    TEST_ASSERT_EQUAL(a.x, a.united(Rect{}).x);
+    TEST_ASSERT_EQUAL(a.w, Rect{}.united(a).w);
+
+    const Rect c = Rect{-5, 120, 20, 20}.clipped(SCREEN);
+    TEST_ASSERT_EQUAL(0, c.x);
+    TEST_ASSERT_EQUAL(120, c.y);
+    TEST_ASSERT_EQUAL(15, c.w);
+    TEST_ASSERT_EQUAL(8, c.h);
+
+    const Rect outside{200, 0, 10, 10};
+    TEST_ASSERT_TRUE(outside.clipped(SCREEN).isEmpty());
+}
+
+static void test_line_bounds_include_both_ends() {
+    const Rect r = lineBounds(64, 64, 20, 100);
+    TEST_ASSERT_EQUAL(20, r.x);
+    TEST_ASSERT_EQUAL(64, r.y);
+    TEST_ASSERT_EQUAL(45, r.w);
+    TEST_ASSERT_EQUAL(37, r.h);
+
+    const Rect dot = lineBounds(5, 5, 5, 5);
+    TEST_ASSERT_EQUAL(1, dot.w * dot.h);
+}
+
+static void test_disjoint_rects_are_pushed_separately() {
+    DirtyRegion region;
+    region.add({0, 0, 10, 10});
+    region.add({50, 50, 10, 10});
+    region.add({100, 0, 5, 5});
+    TEST_ASSERT_EQUAL(3, rectCount(region));
+    TEST_ASSERT_EQUAL(225, pushedPixels(region));
+    TEST_ASSERT_EQUAL(225, coveredPixels(region));
+}
+
+static void test_touching_rects_merge() {
+    DirtyRegion region;
+    region.add({0, 0, 10, 10});
+    region.add({10, 0, 10, 10});
+    TEST_ASSERT_EQUAL(1, rectCount(region));
+    TEST_ASSERT_EQUAL(200, pushedPixels(region));
+}
+
+static void test_merging_cascades() {
+    DirtyRegion region;
+    region.add({0, 0, 10, 10});
+    region.add({40, 0, 10, 10});
+    TEST_ASSERT_EQUAL(2, rectCount(region));
+
+    // Bridges both.
+    region.add({5, 5, 40, 2});
+    TEST_ASSERT_EQUAL(1, rectCount(region));
+    TEST_ASSERT_EQUAL(500, pushedPixels(region));
+}
+
+static void test_overflow_keeps_everything_covered() {
+    DirtyRegion region;
+    const Rect rects[] = {{0, 0, 4, 4}, {20, 0, 4, 4}, {40, 0, 4, 4}, {60, 0, 4, 4}, {80, 80, 4, 4}};
+    for (const auto& rect : rects) {
+        region.add(rect);
+    }
+    TEST_ASSERT_EQUAL(DirtyRegion::MAX_RECTS, rectCount(region));
+    for (const auto& rect : rects) {
+        int covered = 0;
+        for (const auto& r : region) {
+            if (rect.x >= r.x && rect.right() <= r.right() && rect.y >= r.y && rect.bottom() <= r.bottom()) {
+                ++covered;
+            }
+        }
+        TEST_ASSERT_TRUE(covered > 0);
+    }
+    TEST_ASSERT_EQUAL(pushedPixels(region), coveredPixels(region));
+}
+
+static void test_full_screen_is_one_frame() {
+    DirtyRegion region;
+    region.add({10, 10, 5, 5});
+    region.add(SCREEN);
+    TEST_ASSERT_EQUAL(1, rectCount(region));
+    TEST_ASSERT_EQUAL(FRAME_PIXELS, pushedPixels(region));
+}
+
+// Approximates Roboto_Thin_24 - the digital clock font has equally wide digits.
+static int16_t advance(char glyph) {
+    switch (glyph) {
+        case ':': return 6;
+        case '-': return 8;
+        default: return 13;
+    }
+}
+
+static constexpr int16_t LINE_HEIGHT = 29;
+
+// Lays out the text like DigitalClockRenderer::updateLine() and adds the damage of the cells which changed.
+static void updateLine(TextLine& line, const struct tm& timeinfo, const char* format, int16_t x, int16_t y,
+                       DirtyRegion& region) {
+    char text[16];
+    strftime(text, sizeof(text), format, &timeinfo);
+    const TextLine next = TextLine::layout(text, x, advance);
+    region.add(diffCells(line, next, y, LINE_HEIGHT).damage);
+    line = next;
+}
+
+// Steps the digital clock through a day, from the evening before to the morning after so that the date changes too.
+static void test_digital_clock_pixels_per_frame() {
+    const time_t start = 1735668000; // 2024-12-31 18:00 UTC
+    TextLine date{};
+    TextLine time{};
+    struct tm timeinfo;
+    gmtime_r(&start, &timeinfo);
+    DirtyRegion first;
+    updateLine(date, timeinfo, "%F", 0, 20, first);
+    updateLine(time, timeinfo, "%T", 15, 70, first);
+
+    const int seconds = 24 * 60 * 60;
+    int maxPixels = 0;
+    long totalPixels = 0;
+    for (time_t t = start + 1; t <= start + seconds; ++t) {
+        gmtime_r(&t, &timeinfo);
+        DirtyRegion region;
+        updateLine(date, timeinfo, "%F", 0, 20, region);
+        updateLine(time, timeinfo, "%T", 15, 70, region);
+        const int pixels = pushedPixels(region);
+        TEST_ASSERT_TRUE(pixels > 0);
+        maxPixels = std::max(maxPixels, pixels);
+        totalPixels += pixels;
+    }
+
+    char text[96];
+    snprintf(text, sizeof(text), "digital clock: %ld px avg, %d px max per second of %d",
+             totalPixels / seconds, maxPixels, FRAME_PIXELS);
+    TEST_MESSAGE(text);
+
+    // Mostly the last digit and its neighbour, only at midnight both lines.
+    TEST_ASSERT_LESS_OR_EQUAL(3 * 13 * LINE_HEIGHT, totalPixels / seconds);
+    TEST_ASSERT_LESS_OR_EQUAL(pushedPixels(first), maxPixels);
+}
+
+// The analog clock restores and redraws the old and new bounds of each hand which moved - once per second for a
+// whole day.
+static void test_analog_clock_pixels_per_frame() {
+    const time_t start = 1735668000;
+    float positions[HAND_COUNT];
+    struct tm timeinfo;
+    gmtime_r(&start, &timeinfo);
+    handPositions(timeinfo, 0, positions);
+
+    const int seconds = 24 * 60 * 60;
+    int maxPixels = 0;
+    long totalPixels = 0;
+    for (time_t t = start + 1; t <= start + seconds; ++t) {
+        float next[HAND_COUNT];
+        gmtime_r(&t, &timeinfo);
+        handPositions(timeinfo, 0, next);
+        const Rect damage = handDamage(positions, next);
+        std::copy(next, next + HAND_COUNT, positions);
+
+        maxPixels = std::max(maxPixels, damage.w * damage.h);
+        totalPixels += damage.w * damage.h;
+    }
+
+    char text[96];
+    snprintf(text, sizeof(text), "analog clock: %ld px avg, %d px max per second of %d",
+             totalPixels / seconds, maxPixels, FRAME_PIXELS);
+    TEST_MESSAGE(text);
+
+    // Even when all hands move the damage stays within the face.
+    TEST_ASSERT_LESS_OR_EQUAL(FRAME_PIXELS, maxPixels);
+    TEST_ASSERT_LESS_OR_EQUAL(FRAME_PIXELS / 8, totalPixels / seconds);
+}
+
+// The sweeping second hand moves on every frame, the other hands as in the ticking clock.
+static void test_sweeping_clock_pixels_per_frame() {
+    constexpr int FPS = 30;
+    const time_t start = 1735668000;
+    float positions[HAND_COUNT];
+    struct tm timeinfo;
+    gmtime_r(&start, &timeinfo);
+    handPositions(timeinfo, 0, positions);
+
+    int maxPixels = 0;
+    long totalPixels = 0;
+    for (int frame = 1; frame <= 60 * FPS; ++frame) {
+        const time_t t = start + frame / FPS;
+        float next[HAND_COUNT];
+        gmtime_r(&t, &timeinfo);
+        handPositions(timeinfo, float(frame % FPS) / FPS, next);
+        const Rect damage = handDamage(positions, next);
+        std::copy(next, next + HAND_COUNT, positions);
+
+        maxPixels = std::max(maxPixels, damage.w * damage.h);
+        totalPixels += damage.w * damage.h;
+    }
+
+    char text[128];
+    snprintf(text, sizeof(text), "sweeping clock at %d fps: %ld px avg, %d px max per frame, %ld px per second of %d",
+             FPS, totalPixels / (60 * FPS), maxPixels, totalPixels / 60, FRAME_PIXELS * FPS);
+    TEST_MESSAGE(text);
+
+    // A frame only covers the short way the hand moved.
+    TEST_ASSERT_LESS_OR_EQUAL(FRAME_PIXELS / 4, maxPixels);
+    TEST_ASSERT_LESS_THAN(FRAME_PIXELS * FPS / 10, totalPixels / 60);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_rect_united_and_clipped);
+    RUN_TEST(test_line_bounds_include_both_ends);
+    RUN_TEST(test_disjoint_rects_are_pushed_separately);
+    RUN_TEST(test_touching_rects_merge);
+    RUN_TEST(test_merging_cascades);
+    RUN_TEST(test_overflow_keeps_everything_covered);
+    RUN_TEST(test_full_screen_is_one_frame);
+    RUN_TEST(test_digital_clock_pixels_per_frame);
+    RUN_TEST(test_analog_clock_pixels_per_frame);
+    RUN_TEST(test_sweeping_clock_pixels_per_frame);
+    return UNITY_END();
+}
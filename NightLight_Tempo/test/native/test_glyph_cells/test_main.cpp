@@ -0,0 +1,135 @@
+// Project: NightLight
+// Copyright: (c) 2025 Framework Labs
+
+#include "GlyphCells.h"
+
+#include <unity.h>
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+// Approximates Roboto_Thin_24 - the digital clock font has equally wide digits.
+static int16_t advance(char glyph) {
+    switch (glyph) {
+        case ':': return 6;
+        case '-': return 8;
+        default: return 13;
+    }
+}
+
+static constexpr int16_t HEIGHT = 29;
+
+// Applies a diff like DigitalClockRenderer::updateLine() does and counts the glyphs it draws.
+static int update(TextLine& line, const char* text, int16_t x, int16_t y) {
+    const TextLine next = TextLine::layout(text, x, advance);
+    const CellDiff diff = diffCells(line, next, y, HEIGHT);
+    int draws = 0;
+    if (!diff.damage.isEmpty()) {
+        for (int i = 0; i < next.len; ++i) {
+            if (diff.needsDraw(i)) {
+                ++draws;
+            }
+        }
+    }
+    line = next;
+    return draws;
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_layout_advances_cells() {
+    const TextLine line = TextLine::layout("12:34", 15, advance);
+    TEST_ASSERT_EQUAL(5, line.len);
+    TEST_ASSERT_EQUAL(15, line.xs[0]);
+    TEST_ASSERT_EQUAL(28, line.xs[1]);
+    TEST_ASSERT_EQUAL(41, line.xs[2]);
+    TEST_ASSERT_EQUAL(47, line.xs[3]);
+    TEST_ASSERT_EQUAL(15 + 4 * 13 + 6, line.xs[5]);
+}
+
+static void test_last_digit_change_redraws_it_and_its_neighbour() {
+    TextLine line{};
+    update(line, "12:34:56", 15, 70);
+
+    const TextLine next = TextLine::layout("12:34:57", 15, advance);
+    const CellDiff diff = diffCells(line, next, 70, HEIGHT);
+    TEST_ASSERT_EQUAL(8, diff.count);
+    for (int i = 0; i < 7; ++i) {
+        TEST_ASSERT_FALSE(diff.changed[i]);
+    }
+    TEST_ASSERT_TRUE(diff.changed[7]);
+    TEST_ASSERT_EQUAL(next.xs[7], diff.damage.x);
+    TEST_ASSERT_EQUAL(13, diff.damage.w);
+    TEST_ASSERT_TRUE(diff.needsDraw(6));
+    TEST_ASSERT_TRUE(diff.needsDraw(7));
+    TEST_ASSERT_FALSE(diff.needsDraw(5));
+}
+
+static void test_unchanged_line_has_no_damage() {
+    TextLine line{};
+    update(line, "2025-06-14", 0, 20);
+    TEST_ASSERT_EQUAL(0, update(line, "2025-06-14", 0, 20));
+}
+
+static void test_shorter_line_erases_the_dropped_cells() {
+    TextLine line{};
+    update(line, "12345", 0, 0);
+    const TextLine next = TextLine::layout("123", 0, advance);
+    const CellDiff diff = diffCells(line, next, 0, HEIGHT);
+    TEST_ASSERT_EQUAL(5, diff.count);
+    TEST_ASSERT_TRUE(diff.changed[3]);
+    TEST_ASSERT_TRUE(diff.changed[4]);
+    TEST_ASSERT_EQUAL(3 * 13, diff.damage.x);
+    TEST_ASSERT_EQUAL(2 * 13, diff.damage.w);
+}
+
+// Every second of a day, starting from a full redraw - as the digital clock renders it.
+static void test_benchmark_glyph_draws_over_a_day() {
+    const time_t start = 1749859200; // 2025-06-14 00:00:00 UTC
+    constexpr int SECONDS = 24 * 60 * 60;
+
+    TextLine date{};
+    TextLine time{};
+    long draws = 0;
+    long fullDraws = 0;
+    int maxDraws = 0;
+    for (int s = 0; s <= SECONDS; ++s) {
+        const time_t now = start + s;
+        struct tm timeinfo;
+        gmtime_r(&now, &timeinfo);
+        char dateText[TextLine::MAX_GLYPHS + 1];
+        char timeText[TextLine::MAX_GLYPHS + 1];
+        strftime(dateText, sizeof(dateText), "%F", &timeinfo);
+        strftime(timeText, sizeof(timeText), "%T", &timeinfo);
+
+        const int frameDraws = update(date, dateText, 0, 20) + update(time, timeText, 15, 70);
+        if (s > 0) {
+            draws += frameDraws;
+            maxDraws = std::max(maxDraws, frameDraws);
+        }
+        fullDraws += strlen(dateText) + strlen(timeText);
+    }
+    fullDraws -= 18; // The first frame is a full redraw in both cases.
+
+    char text[128];
+    snprintf(text, sizeof(text), "glyph draws over 24 h: %ld changed-cell (%.2f/s, max %d) vs %ld full (%.2f/s)",
+             draws, double(draws) / SECONDS, maxDraws, fullDraws, double(fullDraws) / SECONDS);
+    TEST_MESSAGE(text);
+
+    // Mostly the last digit and the colon next to it.
+    TEST_ASSERT_LESS_THAN(3 * SECONDS, draws);
+    // Midnight changes the date and all of the time.
+    TEST_ASSERT_LESS_OR_EQUAL(18, maxDraws);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_layout_advances_cells);
+    RUN_TEST(test_last_digit_change_redraws_it_and_its_neighbour);
+    RUN_TEST(test_unchanged_line_has_no_damage);
+    RUN_TEST(test_shorter_line_erases_the_dropped_cells);
+    RUN_TEST(test_benchmark_glyph_draws_over_a_day);
+    return UNITY_END();
+}
@@ -0,0 +1,208 @@
+// Project: NightLight
+// Copyright: (c) 2025 Framework Labs
+
+#include "SymbolBundle.h"
+
+#include <unity.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#ifndef WEATHER_BUNDLE_PATH
+#define WEATHER_BUNDLE_PATH "data/weather_symbols.bin"
+#endif
+
+// The pixels which scripts/weather_symbols.py decoded from the source PNGs.
+#ifndef WEATHER_REFERENCE_PATH
+#define WEATHER_REFERENCE_PATH ".pio/build/native/weather_symbols_ref.bin"
+#endif
+
+static constexpr int ICON_SIZE = 55;
+static constexpr int CANVAS_SIZE = 128;
+static constexpr int ICON_X = 36;
+static constexpr int ICON_Y = 10;
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr int REFERENCE_SIZE = 2 + ICON_SIZE * ICON_SIZE * sizeof(uint16_t);
+
+static std::vector<uint8_t> bundle;
+static std::vector<uint8_t> reference;
+static SymbolBundleIndex bundleIndex;
+
+static bool readFile(const char* path, std::vector<uint8_t>& data) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    uint8_t buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data.insert(data.end(), buffer, buffer + n);
+    }
+    fclose(file);
+    return true;
+}
+
+static bool loadBundle() {
+    if (!readFile(WEATHER_BUNDLE_PATH, bundle)) {
+        return false;
+    }
+
+    uint8_t header[SymbolBundleIndex::HEADER_SIZE];
+    if (bundle.size() < sizeof(header)) {
+        return false;
+    }
+    std::copy(bundle.begin(), bundle.begin() + sizeof(header), header);
+    return bundleIndex.parse(header);
+}
+
+static bool loadReference() {
+    if (!readFile(WEATHER_REFERENCE_PATH, reference) ||
+        reference.size() != size_t(SymbolBundleIndex::SYMBOL_COUNT) * REFERENCE_SIZE) {
+        return false;
+    }
+    for (int code = 0; code < SymbolBundleIndex::SYMBOL_COUNT; ++code) {
+        const uint8_t* entry = reference.data() + code * REFERENCE_SIZE;
+        if (entry[0] != ICON_SIZE || entry[1] != ICON_SIZE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// The reference pixels of the code as they would appear in a canvas with the stride.
+static std::vector<uint16_t> referencePixels(int weatherCode, int stride, int x, int y) {
+    const uint8_t* entry = reference.data() + weatherCode * REFERENCE_SIZE;
+    std::vector<uint16_t> pixels(stride * stride);
+    for (int row = 0; row < ICON_SIZE; ++row) {
+        for (int col = 0; col < ICON_SIZE; ++col) {
+            const uint8_t* pixel = entry + 2 + (row * ICON_SIZE + col) * 2;
+            pixels[(y + row) * stride + x + col] = pixel[0] | pixel[1] << 8;
+        }
+    }
+    return pixels;
+}
+
+static RleBitmap bitmapOf(int weatherCode) {
+    const auto& entry = bundleIndex.entryOf(weatherCode);
+    RleBitmap bitmap{};
+    SymbolBundleIndex::bitmapOf(bundle.data() + entry.offset, entry.length, bitmap);
+    return bitmap;
+}
+
+// What a cache miss does: draw the runs into the icon canvas.
+static void decode(const RleBitmap& bitmap, uint16_t* icon, int stride, int x, int y) {
+    forEachRleSpan(bitmap, [&](int32_t col, int32_t row, int32_t len, uint16_t color) {
+        std::fill_n(icon + (y + row) * stride + x + col, len, color);
+    });
+}
+
+// What a cache hit does: copy the decoded icon into the screen canvas.
+static void blit(const uint16_t* icon, uint16_t* canvas) {
+    for (int row = 0; row < ICON_SIZE; ++row) {
+        memcpy(canvas + (ICON_Y + row) * CANVAS_SIZE + ICON_X, icon + row * ICON_SIZE, ICON_SIZE * sizeof(uint16_t));
+    }
+}
+
+static volatile uint16_t sink;
+
+void setUp() {}
+void tearDown() {}
+
+static void test_decode_matches_the_source_pixels() {
+    for (int code = 0; code < SymbolBundleIndex::SYMBOL_COUNT; ++code) {
+        std::vector<uint16_t> icon(ICON_SIZE * ICON_SIZE);
+        decode(bitmapOf(code), icon.data(), ICON_SIZE, 0, 0);
+        const std::vector<uint16_t> expected = referencePixels(code, ICON_SIZE, 0, 0);
+        TEST_ASSERT_EQUAL_MEMORY(expected.data(), icon.data(), icon.size() * sizeof(uint16_t));
+    }
+}
+
+static void test_blit_of_decoded_icon_matches_the_source_pixels() {
+    std::vector<uint16_t> icon(ICON_SIZE * ICON_SIZE);
+    for (int code = 0; code < SymbolBundleIndex::SYMBOL_COUNT; ++code) {
+        std::vector<uint16_t> canvas(CANVAS_SIZE * CANVAS_SIZE);
+        decode(bitmapOf(code), icon.data(), ICON_SIZE, 0, 0);
+        blit(icon.data(), canvas.data());
+        const std::vector<uint16_t> expected = referencePixels(code, CANVAS_SIZE, ICON_X, ICON_Y);
+        TEST_ASSERT_EQUAL_MEMORY(expected.data(), canvas.data(), canvas.size() * sizeof(uint16_t));
+    }
+}
+
+// The decoder must not draw outside the bitmap, whatever the runs say, and has to report them as malformed.
+static void test_malformed_runs_stay_inside_the_bitmap() {
+    const uint16_t palette[] = {0xffff, 0x001f};
+    const uint8_t outOfPalette[] = {0b11, 0, 2 << 2};
+    const uint8_t missingLength[] = {0b11, 0, 1 << 2 | 0b11};
+    const uint8_t tooLong[] = {0b11, 0, 1 << 2 | 0b11, 255};
+    const uint8_t tooShort[] = {0b11, 0};
+    const struct {
+        const uint8_t* runs;
+        uint16_t size;
+    } cases[] = {
+        {outOfPalette, sizeof(outOfPalette)},
+        {missingLength, sizeof(missingLength)},
+        {tooLong, sizeof(tooLong)},
+        {tooShort, sizeof(tooShort)},
+    };
+
+    for (const auto& c : cases) {
+        const RleBitmap bitmap{3, 3, palette, 2, c.runs, c.size};
+        bool isInside = true;
+        const bool isComplete = forEachRleSpan(bitmap, [&](int32_t col, int32_t row, int32_t len, uint16_t) {
+            isInside = isInside && col >= 0 && row >= 0 && row < 3 && len > 0 && col + len <= 3;
+        });
+        TEST_ASSERT_FALSE(isComplete);
+        TEST_ASSERT_TRUE(isInside);
+    }
+}
+
+static void test_benchmark_decode_against_blit() {
+    constexpr int ROUNDS = 200;
+    std::vector<uint16_t> icon(ICON_SIZE * ICON_SIZE);
+    std::vector<uint16_t> canvas(CANVAS_SIZE * CANVAS_SIZE);
+
+    auto start = Clock::now();
+    for (int round = 0; round < ROUNDS; ++round) {
+        for (int code = 0; code < SymbolBundleIndex::SYMBOL_COUNT; ++code) {
+            decode(bitmapOf(code), icon.data(), ICON_SIZE, 0, 0);
+            sink = icon[code];
+        }
+    }
+    const double decodeUs =
+        std::chrono::duration<double, std::micro>(Clock::now() - start).count() / (ROUNDS * SymbolBundleIndex::SYMBOL_COUNT);
+
+    start = Clock::now();
+    for (int round = 0; round < ROUNDS * SymbolBundleIndex::SYMBOL_COUNT; ++round) {
+        blit(icon.data(), canvas.data());
+        sink = canvas[round % canvas.size()];
+    }
+    const double blitUs =
+        std::chrono::duration<double, std::micro>(Clock::now() - start).count() / (ROUNDS * SymbolBundleIndex::SYMBOL_COUNT);
+
+    char text[96];
+    snprintf(text, sizeof(text), "weather icon: decode %.2f us, blit %.2f us per icon on the host", decodeUs, blitUs);
+    TEST_MESSAGE(text);
+}
+
+int main() {
+    if (!loadBundle()) {
+        printf("no bundle at %s - run scripts/weather_symbols.py\n", WEATHER_BUNDLE_PATH);
+        return 1;
+    }
+    if (!loadReference()) {
+        printf("no reference pixels at %s - run scripts/weather_symbols.py\n", WEATHER_REFERENCE_PATH);
+        return 1;
+    }
+
+    UNITY_BEGIN();
+    RUN_TEST(test_decode_matches_the_source_pixels);
+    RUN_TEST(test_blit_of_decoded_icon_matches_the_source_pixels);
+    RUN_TEST(test_malformed_runs_stay_inside_the_bitmap);
+    RUN_TEST(test_benchmark_decode_against_blit);
+    return UNITY_END();
+}
@@ -0,0 +1,86 @@
+// File: Arduino.h
+
+#pragma once
+
+// Stands in for the FreeRTOS queues and tasks which IoWorker.h uses, so the worker runs on the host - with a tick of
+// one millisecond and a thread per task.
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using BaseType_t = int;
+using UBaseType_t = unsigned;
+using TickType_t = uint32_t;
+
+constexpr BaseType_t pdTRUE = 1;
+constexpr BaseType_t pdFALSE = 0;
+constexpr TickType_t portMAX_DELAY = 0xffffffff;
+
+struct HostQueue {
+    UBaseType_t length;
+    UBaseType_t itemSize;
+    std::deque<std::vector<uint8_t>> items;
+    std::mutex mutex;
+    std::condition_variable changed;
+};
+
+using QueueHandle_t = HostQueue*;
+
+// Never deleted - like the queues of the worker on the device.
+inline QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+    auto* queue = new HostQueue;
+    queue->length = length;
+    queue->itemSize = itemSize;
+    return queue;
+}
+
+template <typename Predicate>
+inline bool waitTicks(HostQueue& queue, std::unique_lock<std::mutex>& lock, TickType_t ticks, Predicate predicate) {
+    if (ticks == portMAX_DELAY) {
+        queue.changed.wait(lock, predicate);
+        return true;
+    }
+    return queue.changed.wait_for(lock, std::chrono::milliseconds(ticks), predicate);
+}
+
+inline BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!waitTicks(*queue, lock, ticks, [&] { return queue->items.size() < queue->length; })) {
+        return pdFALSE;
+    }
+    const auto* bytes = static_cast<const uint8_t*>(item);
+    queue->items.emplace_back(bytes, bytes + queue->itemSize);
+    queue->changed.notify_all();
+    return pdTRUE;
+}
+
+inline BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!waitTicks(*queue, lock, ticks, [&] { return !queue->items.empty(); })) {
+        return pdFALSE;
+    }
+    memcpy(item, queue->items.front().data(), queue->itemSize);
+    queue->items.pop_front();
+    queue->changed.notify_all();
+    return pdTRUE;
+}
+
+using TaskFunction_t = void (*)(void*);
+using TaskHandle_t = void*;
+
+// The task runs detached until the process ends - the stack size, priority and core do not matter on the host.
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char*, uint32_t, void* parameter, UBaseType_t,
+                                          TaskHandle_t*, BaseType_t) {
+    std::thread(function, parameter).detach();
+    return pdTRUE;
+}
+
+inline void delay(uint32_t ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
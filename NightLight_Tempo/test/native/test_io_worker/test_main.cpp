@@ -0,0 +1,203 @@
+// Project: NightLight
+// Copyright: (c) 2025 Framework Labs
+
+#include "IoWorker.h"
+
+#include <unity.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+// The worker task runs on a thread here, with the FreeRTOS queues of the Arduino.h next to this file - the soak test
+// in test/embedded runs the same on the device.
+
+// Counts the blocks allocated and not yet freed.
+static std::atomic<long> liveBlocks{0};
+
+void* operator new(size_t size) {
+    void* ptr = malloc(size);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    ++liveBlocks;
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    if (ptr) {
+        --liveBlocks;
+        free(ptr);
+    }
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+
+static IoWorker worker;
+
+// Allocates and frees on the worker like a weather fetch does with its connection and response.
+class SoakJob : public IoJob {
+public:
+    std::atomic<int> runs{0};
+
+protected:
+    void run() override {
+        std::unique_ptr<char[]> response(new char[2048]);
+        snprintf(response.get(), 2048, "{\"run\":%d}", runs.load());
+        ++runs;
+    }
+};
+
+// Blocks the worker until released - to fill the queue behind it.
+class GateJob : public IoJob {
+public:
+    std::atomic<bool> isRunning{false};
+    std::atomic<bool> isReleased{false};
+
+protected:
+    void run() override {
+        isRunning = true;
+        while (!isReleased) {
+            delay(1);
+        }
+        isRunning = false;
+    }
+};
+
+// Records the order the jobs ran in and whether two ever overlapped.
+static std::atomic<int> runningJobs{0};
+static std::atomic<int> nextOrder{0};
+static std::atomic<bool> didOverlap{false};
+
+class OrderJob : public IoJob {
+public:
+    int order = -1;
+
+protected:
+    void run() override {
+        if (++runningJobs > 1) {
+            didOverlap = true;
+        }
+        delay(1);
+        order = nextOrder++;
+        --runningJobs;
+    }
+};
+
+static void awaitCompletion(IoJob& job) {
+    while (job.isPending()) {
+        delay(1);
+        worker.deliverCompletions();
+    }
+}
+
+// Posts the job and delivers completions until it is done - like the WeatherProvider does tick by tick.
+static void cycle(SoakJob& job, int count) {
+    for (int i = 0; i < count; ++i) {
+        TEST_ASSERT_TRUE(worker.post(job));
+        awaitCompletion(job);
+    }
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_pending_job_is_not_posted_again() {
+    SoakJob job;
+    TEST_ASSERT_TRUE(worker.post(job));
+    TEST_ASSERT_FALSE(worker.post(job));
+    awaitCompletion(job);
+    TEST_ASSERT_EQUAL(1, job.runs.load());
+}
+
+// Results must only be read after the completion got delivered before a tick, never while the worker still runs.
+static void test_completion_waits_for_delivery() {
+    GateJob gate;
+    TEST_ASSERT_TRUE(worker.post(gate));
+    while (!gate.isRunning) {
+        delay(1);
+    }
+    worker.deliverCompletions();
+    TEST_ASSERT_TRUE(gate.isPending());
+
+    gate.isReleased = true;
+    while (gate.isRunning) {
+        delay(1);
+    }
+    delay(10);
+    TEST_ASSERT_TRUE(gate.isPending());
+    worker.deliverCompletions();
+    TEST_ASSERT_FALSE(gate.isPending());
+}
+
+static void test_full_queue_rejects_jobs() {
+    GateJob gate;
+    TEST_ASSERT_TRUE(worker.post(gate));
+    while (!gate.isRunning) {
+        delay(1);
+    }
+
+    SoakJob queued[IoWorker::QUEUE_LENGTH];
+    for (auto& job : queued) {
+        TEST_ASSERT_TRUE(worker.post(job));
+    }
+    SoakJob rejected;
+    TEST_ASSERT_FALSE(worker.post(rejected));
+    TEST_ASSERT_FALSE(rejected.isPending());
+
+    gate.isReleased = true;
+    awaitCompletion(gate);
+    for (auto& job : queued) {
+        awaitCompletion(job);
+        TEST_ASSERT_EQUAL(1, job.runs.load());
+    }
+    TEST_ASSERT_EQUAL(0, rejected.runs.load());
+}
+
+static void test_jobs_run_one_after_the_other_in_order() {
+    OrderJob jobs[IoWorker::QUEUE_LENGTH];
+    nextOrder = 0;
+    for (auto& job : jobs) {
+        TEST_ASSERT_TRUE(worker.post(job));
+    }
+    for (auto& job : jobs) {
+        awaitCompletion(job);
+    }
+    for (int i = 0; i < IoWorker::QUEUE_LENGTH; ++i) {
+        TEST_ASSERT_EQUAL(i, jobs[i].order);
+    }
+    TEST_ASSERT_FALSE(didOverlap.load());
+}
+
+static void test_thousands_of_cycles_keep_memory_flat() {
+    constexpr int CYCLES = 5000;
+
+    SoakJob job;
+    cycle(job, 100); // Whatever gets allocated lazily on first use.
+    const long blocks = liveBlocks;
+
+    cycle(job, CYCLES);
+
+    char text[96];
+    snprintf(text, sizeof(text), "%d cycles: %ld blocks allocated before, %ld after", CYCLES, blocks, liveBlocks.load());
+    TEST_MESSAGE(text);
+
+    TEST_ASSERT_EQUAL(100 + CYCLES, job.runs.load());
+    TEST_ASSERT_EQUAL(blocks, liveBlocks.load());
+}
+
+int main() {
+    worker.init();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_pending_job_is_not_posted_again);
+    RUN_TEST(test_completion_waits_for_delivery);
+    RUN_TEST(test_full_queue_rejects_jobs);
+    RUN_TEST(test_jobs_run_one_after_the_other_in_order);
+    RUN_TEST(test_thousands_of_cycles_keep_memory_flat);
+    return UNITY_END();
+}
@@ -0,0 +1,155 @@
+// Project: NightLight
+// Copyright: (c) 2025 Framework Labs
+
+#include "SecondBoundary.h"
+
+#include <unity.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// The main loop ticks every 100 ms of the FreeRTOS tick, which drifts against the NTP corrected wall clock, and the
+// loop task wakes a little late now and then.
+static constexpr int64_t TICK_US = 100000;
+static constexpr double DRIFT_PPM = 100;
+static constexpr int64_t MAX_JITTER_US = 5000;
+static constexpr int64_t HOUR_US = 3600LL * 1000000;
+static constexpr int RUNS = 20;
+
+struct Errors {
+    std::vector<int64_t> latenciesUs; // From each second boundary until the display shows that second.
+    int skipped = 0;                  // Seconds which never got displayed.
+    int repeated = 0;                 // Updates which showed the second already on display.
+};
+
+// Runs the 10 Hz loop for an hour from a random phase and records how late each wall clock second gets displayed -
+// either right after the boundary or, like pa_every_s (1), on every tenth tick since the activation.
+static void simulate(bool isAligned, std::mt19937& random, Errors& errors) {
+    std::uniform_int_distribution<int64_t> phase(0, 1000000 - 1);
+    std::uniform_int_distribution<int64_t> jitter(0, MAX_JITTER_US);
+
+    const int64_t startUs = 1749859200LL * 1000000 + phase(random);
+    std::vector<int64_t> shownUs(HOUR_US / 1000000 + 2, -1);
+    SecondBoundary boundary;
+    time_t displayed = 0;
+
+    for (int64_t tick = 0;; ++tick) {
+        const int64_t nowUs = startUs + int64_t(tick * TICK_US * (1 + DRIFT_PPM / 1e6)) + jitter(random);
+        if (nowUs - startUs > HOUR_US) {
+            break;
+        }
+        const time_t sec = nowUs / 1000000;
+
+        const bool isDue = isAligned ? boundary.crossed(sec) : tick % 10 == 0;
+        if (!isDue) {
+            continue;
+        }
+        if (sec == displayed) {
+            ++errors.repeated;
+        }
+        displayed = sec;
+
+        const size_t index = sec - startUs / 1000000;
+        if (shownUs[index] < 0) {
+            shownUs[index] = nowUs;
+        }
+    }
+
+    // The first second may have started before the activation.
+    for (size_t index = 1; index < shownUs.size() - 1; ++index) {
+        if (shownUs[index] < 0) {
+            ++errors.skipped;
+        } else {
+            errors.latenciesUs.push_back(shownUs[index] - (startUs / 1000000 + int64_t(index)) * 1000000);
+        }
+    }
+}
+
+static void report(const char* name, Errors& errors) {
+    auto& latencies = errors.latenciesUs;
+    std::sort(latencies.begin(), latencies.end());
+    int64_t sum = 0;
+    for (auto latency : latencies) {
+        sum += latency;
+    }
+
+    char text[160];
+    snprintf(text, sizeof(text), "%s: %zu seconds, latency mean %lld ms, p50 %lld ms, p99 %lld ms, max %lld ms, "
+             "%d skipped, %d repeated", name, latencies.size(), (long long)(sum / int64_t(latencies.size()) / 1000),
+             (long long)(latencies[latencies.size() / 2] / 1000), (long long)(latencies[latencies.size() * 99 / 100] / 1000),
+             (long long)(latencies.back() / 1000), errors.skipped, errors.repeated);
+    TEST_MESSAGE(text);
+
+    // The distribution in steps of 100 ms.
+    int buckets[10] = {};
+    for (auto latency : latencies) {
+        ++buckets[std::min<int64_t>(latency / 100000, 9)];
+    }
+    snprintf(text, sizeof(text), "%s: per 100 ms %d %d %d %d %d %d %d %d %d %d", name, buckets[0], buckets[1],
+             buckets[2], buckets[3], buckets[4], buckets[5], buckets[6], buckets[7], buckets[8], buckets[9]);
+    TEST_MESSAGE(text);
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_crossed_once_per_second() {
+    SecondBoundary boundary;
+    TEST_ASSERT_TRUE(boundary.crossed(100));
+    TEST_ASSERT_FALSE(boundary.crossed(100));
+    TEST_ASSERT_TRUE(boundary.crossed(101));
+    TEST_ASSERT_TRUE(boundary.crossed(103));
+    boundary.reset();
+    TEST_ASSERT_TRUE(boundary.crossed(103));
+}
+
+static void test_aligned_display_is_within_a_tick() {
+    std::mt19937 random(1);
+    Errors errors;
+    for (int run = 0; run < RUNS; ++run) {
+        simulate(true, random, errors);
+    }
+    report("aligned", errors);
+
+    TEST_ASSERT_EQUAL(0, errors.skipped);
+    TEST_ASSERT_EQUAL(0, errors.repeated);
+    TEST_ASSERT_TRUE(errors.latenciesUs.back() <= TICK_US + MAX_JITTER_US);
+}
+
+static void test_phase_locked_display() {
+    std::mt19937 random(1);
+    Errors errors;
+    for (int run = 0; run < RUNS; ++run) {
+        simulate(false, random, errors);
+    }
+    report("pa_every_s", errors);
+
+    TEST_ASSERT_TRUE(errors.latenciesUs.back() > TICK_US + MAX_JITTER_US);
+}
+
+static void test_clock_set_from_2017_on() {
+    struct tm timeinfo{};
+    timeinfo.tm_mday = 1;
+    timeinfo.tm_year = 70;
+    TEST_ASSERT_FALSE(isClockSet(timeinfo));
+    timeinfo.tm_year = 2016 - 1900;
+    TEST_ASSERT_FALSE(isClockSet(timeinfo));
+    timeinfo.tm_year = 2017 - 1900;
+    TEST_ASSERT_TRUE(isClockSet(timeinfo));
+
+    TEST_ASSERT_FALSE(isClockSet(time_t(0)));
+    TEST_ASSERT_FALSE(isClockSet(time_t(3600)));
+    TEST_ASSERT_TRUE(isClockSet(time_t(1735668000)));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_crossed_once_per_second);
+    RUN_TEST(test_aligned_display_is_within_a_tick);
+    RUN_TEST(test_phase_locked_display);
+    RUN_TEST(test_clock_set_from_2017_on);
+    return UNITY_END();
+}
@@ -0,0 +1,123 @@
+// Project: NightLight
+// Copyright: (c) 2025 Framework Labs
+
+#include "SpinnerGeometry.h"
+
+#include <unity.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+static constexpr int SIZE = 128;
+static constexpr uint8_t BLACK = 0;
+
+// Stands in for fillArc: sets every pixel which the arc touches, with three quarters of a pixel of tolerance all around - a
+// rasterizer may set any of them, but nothing beyond.
+static void fillArc(std::vector<uint8_t>& canvas, float from, float to, uint8_t color) {
+    for (int y = 0; y < SIZE; ++y) {
+        for (int x = 0; x < SIZE; ++x) {
+            const float dx = x - 64.0f;
+            const float dy = y - 64.0f;
+            const float r = sqrtf(dx * dx + dy * dy);
+            if (r < ARC_INNER_RADIUS - 0.75f || r > ARC_OUTER_RADIUS + 0.75f) {
+                continue;
+            }
+            float deg = atan2f(dy, dx) / SPINNER_DEG_TO_RAD;
+            const float tolerance = 0.75f / r / SPINNER_DEG_TO_RAD;
+            while (deg < from - tolerance) {
+                deg += 360;
+            }
+            if (deg <= to + tolerance) {
+                canvas[y * SIZE + x] = color;
+            }
+        }
+    }
+}
+
+static void fillRect(std::vector<uint8_t>& canvas, const Rect& rect, uint8_t color) {
+    for (int y = rect.y; y < rect.bottom(); ++y) {
+        memset(canvas.data() + y * SIZE + rect.x, color, rect.w);
+    }
+}
+
+static bool isInside(const Rect& rect, int x, int y) {
+    return x >= rect.x && x < rect.right() && y >= rect.y && y < rect.bottom();
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_bounds_contain_the_arc() {
+    for (float from = 0; from < 360; from += 1) {
+        std::vector<uint8_t> canvas(SIZE * SIZE, BLACK);
+        fillArc(canvas, from, from + ARC_LEN, 1);
+        const Rect bounds = arcBounds(from, from + ARC_LEN);
+        for (int y = 0; y < SIZE; ++y) {
+            for (int x = 0; x < SIZE; ++x) {
+                if (canvas[y * SIZE + x] != BLACK && !isInside(bounds, x, y)) {
+                    char text[64];
+                    snprintf(text, sizeof(text), "arc from %.0f sets %d, %d outside its bounds", from, x, y);
+                    TEST_FAIL_MESSAGE(text);
+                }
+            }
+        }
+    }
+}
+
+// Runs the spinner through two full turns - one per color - with the steps SpinnerRenderer::render() takes. Every
+// frame has to match a full redraw and may only change pixels within the damage of its step.
+static void test_steps_match_a_full_redraw() {
+    std::vector<uint8_t> canvas(SIZE * SIZE, BLACK);
+    float angle = 0;
+    uint8_t color = 1;
+    fillArc(canvas, angle, angle + ARC_LEN, color);
+
+    int maxPixels = 0;
+    long totalPixels = 0;
+    const int frames = 2 * int(360 / ARC_INC);
+    for (int frame = 0; frame < frames; ++frame) {
+        const std::vector<uint8_t> previous = canvas;
+        const SpinnerStep step = spinnerStep(angle);
+        if (step.isRecolored) {
+            color = color == 1 ? 2 : 1;
+        }
+        fillRect(canvas, step.erase, BLACK);
+        fillArc(canvas, step.angle, step.angle + ARC_LEN, color);
+        angle = step.angle;
+
+        std::vector<uint8_t> full(SIZE * SIZE, BLACK);
+        fillArc(full, angle, angle + ARC_LEN, color);
+        TEST_ASSERT_EQUAL_MEMORY(full.data(), canvas.data(), canvas.size());
+
+        for (int y = 0; y < SIZE; ++y) {
+            for (int x = 0; x < SIZE; ++x) {
+                if (canvas[y * SIZE + x] != previous[y * SIZE + x] &&
+                    !isInside(step.damage[0], x, y) && !isInside(step.damage[1], x, y)) {
+                    char text[64];
+                    snprintf(text, sizeof(text), "step from %.0f changes %d, %d outside its damage", angle, x, y);
+                    TEST_FAIL_MESSAGE(text);
+                }
+            }
+        }
+
+        const int pixels = step.damage[0].w * step.damage[0].h + step.damage[1].w * step.damage[1].h;
+        maxPixels = std::max(maxPixels, pixels);
+        totalPixels += pixels;
+    }
+
+    char text[96];
+    snprintf(text, sizeof(text), "wait screen: %ld px avg, %d px max per frame of %d",
+             totalPixels / frames, maxPixels, SIZE * SIZE);
+    TEST_MESSAGE(text);
+    TEST_ASSERT_LESS_THAN(SIZE * SIZE / 8, maxPixels);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_bounds_contain_the_arc);
+    RUN_TEST(test_steps_match_a_full_redraw);
+    return UNITY_END();
+}
@@ -0,0 +1,184 @@
+// Project: NightLight
+// Copyright: (c) 2025 Framework Labs
+
+#include "SymbolBundle.h"
+
+#include <unity.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+// Written by scripts/weather_symbols.py, which the native environment runs before the build.
+#ifndef WEATHER_BUNDLE_PATH
+#define WEATHER_BUNDLE_PATH "data/weather_symbols.bin"
+#endif
+
+static constexpr int ICON_SIZE = 55;
+
+static std::vector<uint8_t> bundle;
+
+static std::vector<uint8_t> readBundle() {
+    std::vector<uint8_t> data;
+    FILE* file = fopen(WEATHER_BUNDLE_PATH, "rb");
+    if (!file) {
+        return data;
+    }
+    uint8_t buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data.insert(data.end(), buffer, buffer + n);
+    }
+    fclose(file);
+    return data;
+}
+
+static bool parseIndex(const std::vector<uint8_t>& data, SymbolBundleIndex& index) {
+    uint8_t header[SymbolBundleIndex::HEADER_SIZE];
+    if (data.size() < sizeof(header)) {
+        return false;
+    }
+    std::copy(data.begin(), data.begin() + sizeof(header), header);
+    return index.parse(header);
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_bundle_exists() {
+    TEST_ASSERT_TRUE_MESSAGE(!bundle.empty(), "no bundle at " WEATHER_BUNDLE_PATH " - run scripts/weather_symbols.py");
+}
+
+static void test_header_of_other_versions_is_rejected() {
+    std::vector<uint8_t> data = bundle;
+    SymbolBundleIndex index;
+    TEST_ASSERT_TRUE(parseIndex(data, index));
+
+    data[4] = SymbolBundleIndex::VERSION + 1;
+    TEST_ASSERT_FALSE(parseIndex(data, index));
+
+    data = bundle;
+    data[0] = 'X';
+    TEST_ASSERT_FALSE(parseIndex(data, index));
+}
+
+// What the generator used to assert at compile time: every WMO code resolves to a complete symbol.
+static void test_every_code_resolves_to_a_complete_symbol() {
+    SymbolBundleIndex index;
+    TEST_ASSERT_TRUE(parseIndex(bundle, index));
+
+    for (int code = 0; code < SymbolBundleIndex::SYMBOL_COUNT; ++code) {
+        const auto& entry = index.entryOf(code);
+        TEST_ASSERT_TRUE(entry.length >= SymbolBundleIndex::RECORD_HEADER_SIZE);
+        TEST_ASSERT_TRUE(entry.offset >= SymbolBundleIndex::HEADER_SIZE);
+        TEST_ASSERT_TRUE(entry.offset + entry.length <= bundle.size());
+
+        const uint8_t* record = bundle.data() + entry.offset;
+        RleBitmap bitmap;
+        TEST_ASSERT_TRUE(SymbolBundleIndex::bitmapOf(record, entry.length, bitmap));
+        TEST_ASSERT_EQUAL(ICON_SIZE, bitmap.width);
+        TEST_ASSERT_EQUAL(ICON_SIZE, bitmap.height);
+
+        // The runs have to cover the bitmap exactly and only use palette colors.
+        const uint8_t paletteSize = record[2];
+        bool isPaletteValid = true;
+        for (const uint8_t* run = bitmap.runs; run != bitmap.runs + bitmap.runsSize; ++run) {
+            isPaletteValid = isPaletteValid && (*run >> 2) < paletteSize;
+            if ((*run & 0b11) == 3) {
+                ++run;
+            }
+        }
+        TEST_ASSERT_TRUE(isPaletteValid);
+
+        long pixels = 0;
+        int lastRow = 0;
+        forEachRleSpan(bitmap, [&](int32_t col, int32_t row, int32_t len, uint16_t) {
+            pixels += len;
+            lastRow = row;
+            (void)col;
+        });
+        TEST_ASSERT_EQUAL(ICON_SIZE * ICON_SIZE, pixels);
+        TEST_ASSERT_EQUAL(ICON_SIZE - 1, lastRow);
+    }
+}
+
+static void test_unknown_codes_show_code_zero() {
+    SymbolBundleIndex index;
+    TEST_ASSERT_TRUE(parseIndex(bundle, index));
+    TEST_ASSERT_EQUAL(index.entryOf(0).offset, index.entryOf(-1).offset);
+    TEST_ASSERT_EQUAL(index.entryOf(0).offset, index.entryOf(SymbolBundleIndex::SYMBOL_COUNT).offset);
+}
+
+static void test_truncated_record_is_rejected() {
+    const uint8_t record[] = {55, 55, 8, 0, 0xff, 0xff};
+    RleBitmap bitmap;
+    TEST_ASSERT_FALSE(SymbolBundleIndex::bitmapOf(record, sizeof(record), bitmap));
+    TEST_ASSERT_FALSE(SymbolBundleIndex::bitmapOf(record, 3, bitmap));
+}
+
+// A stale or partly written bundle on LittleFS can cut a record anywhere.
+static void test_cut_records_are_rejected() {
+    SymbolBundleIndex index;
+    TEST_ASSERT_TRUE(parseIndex(bundle, index));
+
+    const auto& entry = index.entryOf(0);
+    const uint8_t* record = bundle.data() + entry.offset;
+    RleBitmap bitmap;
+    TEST_ASSERT_TRUE(SymbolBundleIndex::bitmapOf(record, entry.length, bitmap));
+    for (size_t length = 0; length < entry.length; ++length) {
+        TEST_ASSERT_FALSE(SymbolBundleIndex::bitmapOf(record, length, bitmap));
+    }
+}
+
+static void test_corrupt_records_are_rejected() {
+    SymbolBundleIndex index;
+    TEST_ASSERT_TRUE(parseIndex(bundle, index));
+
+    const auto& entry = index.entryOf(0);
+    const std::vector<uint8_t> record(bundle.begin() + entry.offset, bundle.begin() + entry.offset + entry.length);
+    const size_t runsOffset = SymbolBundleIndex::RECORD_HEADER_SIZE + record[2] * sizeof(uint16_t);
+    RleBitmap bitmap;
+
+    // A color beyond the palette.
+    std::vector<uint8_t> data = record;
+    data[runsOffset] = uint8_t(record[2] << 2 | (record[runsOffset] & 0b11));
+    TEST_ASSERT_FALSE(SymbolBundleIndex::bitmapOf(data.data(), data.size(), bitmap));
+
+    // More pixels than the bitmap has.
+    data = record;
+    data.push_back(0);
+    TEST_ASSERT_FALSE(SymbolBundleIndex::bitmapOf(data.data(), data.size(), bitmap));
+
+    // Fewer pixels than the bitmap has.
+    data = record;
+    data[1] += 1;
+    TEST_ASSERT_FALSE(SymbolBundleIndex::bitmapOf(data.data(), data.size(), bitmap));
+}
+
+static void test_long_run_needs_its_length_byte() {
+    // A 2x2 bitmap with a single white color.
+    const uint8_t valid[] = {2, 2, 1, 0, 0xff, 0xff, 0b11, 0};
+    RleBitmap bitmap;
+    TEST_ASSERT_TRUE(SymbolBundleIndex::bitmapOf(valid, sizeof(valid), bitmap));
+    TEST_ASSERT_FALSE(SymbolBundleIndex::bitmapOf(valid, sizeof(valid) - 1, bitmap));
+
+    const uint8_t outOfPalette[] = {2, 2, 1, 0, 0xff, 0xff, 1 << 2 | 0b11, 0};
+    TEST_ASSERT_FALSE(SymbolBundleIndex::bitmapOf(outOfPalette, sizeof(outOfPalette), bitmap));
+}
+
+int main() {
+    bundle = readBundle();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_bundle_exists);
+    if (!bundle.empty()) {
+        RUN_TEST(test_header_of_other_versions_is_rejected);
+        RUN_TEST(test_every_code_resolves_to_a_complete_symbol);
+        RUN_TEST(test_unknown_codes_show_code_zero);
+        RUN_TEST(test_cut_records_are_rejected);
+        RUN_TEST(test_corrupt_records_are_rejected);
+    }
+    RUN_TEST(test_truncated_record_is_rejected);
+    RUN_TEST(test_long_run_needs_its_length_byte);
+    return UNITY_END();
+}
@@ -0,0 +1,121 @@
+// Project: NightLight
+// Copyright: (c) 2025 Framework Labs
+
+#include "TripleBuffer.h"
+
+#include <unity.h>
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+
+// Big enough that a torn read shows up as words of different sequence numbers.
+struct Payload {
+    static constexpr int WORDS = 16;
+
+    uint32_t seq;
+    uint32_t words[WORDS];
+
+    void fill(uint32_t n) {
+        seq = n;
+        for (int i = 0; i < WORDS; ++i) {
+            words[i] = n * 31 + i;
+        }
+    }
+
+    bool isConsistent() const {
+        for (int i = 0; i < WORDS; ++i) {
+            if (words[i] != seq * 31 + i) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+void setUp() {}
+void tearDown() {}
+
+static void test_nothing_to_fetch_before_publish() {
+    TripleBuffer<Payload> buffer;
+    TEST_ASSERT_FALSE(buffer.fetch());
+
+    buffer.back().fill(1);
+    buffer.publish();
+    TEST_ASSERT_TRUE(buffer.fetch());
+    TEST_ASSERT_EQUAL(1, buffer.front().seq);
+    TEST_ASSERT_FALSE(buffer.fetch());
+    TEST_ASSERT_EQUAL(1, buffer.front().seq);
+}
+
+static void test_consumer_gets_the_latest_value() {
+    TripleBuffer<Payload> buffer;
+    for (uint32_t n = 1; n <= 5; ++n) {
+        buffer.back().fill(n);
+        buffer.publish();
+    }
+    TEST_ASSERT_TRUE(buffer.fetch());
+    TEST_ASSERT_EQUAL(5, buffer.front().seq);
+}
+
+// A producer thread hammers updates while the consumer checks every value it fetches.
+static void test_stress_no_torn_or_out_of_order_values() {
+    constexpr uint32_t UPDATES = 2000000;
+
+    TripleBuffer<Payload> buffer;
+    std::atomic<bool> isDone{false};
+
+    std::thread producer([&] {
+        for (uint32_t n = 1; n <= UPDATES; ++n) {
+            buffer.back().fill(n);
+            buffer.publish();
+            // Also interleaves the threads on a single core.
+            if (n % 64 == 0) {
+                std::this_thread::yield();
+            }
+        }
+        isDone = true;
+    });
+
+    uint32_t fetched = 0;
+    uint32_t torn = 0;
+    uint32_t outOfOrder = 0;
+    uint32_t last = 0;
+    while (true) {
+        // Checked before the fetch, so the final value is fetched after the producer is done.
+        const bool wasDone = isDone;
+        if (buffer.fetch()) {
+            const Payload& value = buffer.front();
+            ++fetched;
+            if (!value.isConsistent()) {
+                ++torn;
+            }
+            if (value.seq <= last) {
+                ++outOfOrder;
+            }
+            last = value.seq;
+        } else if (wasDone) {
+            break;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    char text[128];
+    snprintf(text, sizeof(text), "%u updates: %u fetched, %u torn, %u out of order, last %u", UPDATES, fetched, torn,
+             outOfOrder, last);
+    TEST_MESSAGE(text);
+
+    TEST_ASSERT_EQUAL(0, torn);
+    TEST_ASSERT_EQUAL(0, outOfOrder);
+    TEST_ASSERT_EQUAL(UPDATES, last);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_nothing_to_fetch_before_publish);
+    RUN_TEST(test_consumer_gets_the_latest_value);
+    RUN_TEST(test_stress_no_torn_or_out_of_order_values);
+    return UNITY_END();
+}
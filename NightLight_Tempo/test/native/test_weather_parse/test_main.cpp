@@ -0,0 +1,254 @@
+// Project: NightLight
+// Copyright: (c) 2025 Framework Labs
+
+#include "WeatherData.h"
+
+#include <unity.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+
+// Shaped like the responses of the open-meteo forecast request in main.cpp - written by hand, not recorded.
+static const char* const SUMMER_PAYLOAD = R"({"latitude":48.14,"longitude":11.58,"generationtime_ms":0.0569820404052734,)"
+    R"("utc_offset_seconds":7200,"timezone":"Europe/Berlin","timezone_abbreviation":"CEST","elevation":526.0,)"
+    R"("current_units":{"time":"iso8601","interval":"seconds","temperature_2m":"°C"},)"
+    R"("current":{"time":"2025-06-14T14:45","interval":900,"temperature_2m":24.3},)"
+    R"("daily_units":{"time":"iso8601","temperature_2m_max":"°C","temperature_2m_min":"°C","weather_code":"wmo code",)"
+    R"("precipitation_probability_max":"%"},)"
+    R"("daily":{"time":["2025-06-14"],"temperature_2m_max":[27.1],"temperature_2m_min":[13.9],"weather_code":[3],)"
+    R"("precipitation_probability_max":[12]}})";
+
+static const char* const WINTER_PAYLOAD = R"({"latitude":48.14,"longitude":11.58,"generationtime_ms":0.0410079956054688,)"
+    R"("utc_offset_seconds":3600,"timezone":"Europe/Berlin","timezone_abbreviation":"CET","elevation":526.0,)"
+    R"("current_units":{"time":"iso8601","interval":"seconds","temperature_2m":"°C"},)"
+    R"("current":{"time":"2025-01-09T07:15","interval":900,"temperature_2m":-6.8},)"
+    R"("daily_units":{"time":"iso8601","temperature_2m_max":"°C","temperature_2m_min":"°C","weather_code":"wmo code",)"
+    R"("precipitation_probability_max":"%"},)"
+    R"("daily":{"time":["2025-01-09"],"temperature_2m_max":[-1.2],"temperature_2m_min":[-9.5],"weather_code":[73],)"
+    R"("precipitation_probability_max":[87]}})";
+
+// The same with an hourly forecast, as if the API started to send more than asked for.
+static std::string withHourlyForecast(const char* payload) {
+    std::string text(payload);
+    text.pop_back();
+    text += R"(,"hourly_units":{"time":"iso8601","temperature_2m":"°C","relative_humidity_2m":"%"},"hourly":{"time":[)";
+    for (int hour = 0; hour < 24; ++hour) {
+        char value[32];
+        snprintf(value, sizeof(value), "%s\"2025-06-14T%02d:00\"", hour ? "," : "", hour);
+        text += value;
+    }
+    text += R"(],"temperature_2m":[)";
+    for (int hour = 0; hour < 24; ++hour) {
+        char value[16];
+        snprintf(value, sizeof(value), "%s%.1f", hour ? "," : "", 14.0 + hour % 12);
+        text += value;
+    }
+    text += R"(],"relative_humidity_2m":[)";
+    for (int hour = 0; hour < 24; ++hour) {
+        char value[16];
+        snprintf(value, sizeof(value), "%s%d", hour ? "," : "", 40 + hour);
+        text += value;
+    }
+    text += "]}}";
+    return text;
+}
+
+// Counts the heap in use and its peak - of strings through operator new and of document pools through
+// CountingAllocator, as ArduinoJson allocates those with malloc().
+static size_t heapBytes;
+static size_t peakHeapBytes;
+
+static void* countedMalloc(size_t size) {
+    auto* block = static_cast<size_t*>(malloc(size + sizeof(std::max_align_t)));
+    if (!block) {
+        return nullptr;
+    }
+    *block = size;
+    heapBytes += size;
+    peakHeapBytes = std::max(peakHeapBytes, heapBytes);
+    return reinterpret_cast<char*>(block) + sizeof(std::max_align_t);
+}
+
+static void countedFree(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    auto* block = reinterpret_cast<size_t*>(static_cast<char*>(ptr) - sizeof(std::max_align_t));
+    heapBytes -= *block;
+    free(block);
+}
+
+void* operator new(size_t size) {
+    void* ptr = countedMalloc(size);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    countedFree(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    countedFree(ptr);
+}
+
+struct CountingAllocator {
+    void* allocate(size_t size) {
+        return countedMalloc(size);
+    }
+
+    void deallocate(void* ptr) {
+        countedFree(ptr);
+    }
+
+    void* reallocate(void* ptr, size_t size) {
+        void* moved = countedMalloc(size);
+        if (moved && ptr) {
+            const auto* block = reinterpret_cast<size_t*>(static_cast<char*>(ptr) - sizeof(std::max_align_t));
+            memcpy(moved, ptr, std::min(*block, size));
+        }
+        countedFree(ptr);
+        return moved;
+    }
+};
+
+using CountingJsonDocument = ArduinoJson::BasicJsonDocument<CountingAllocator>;
+
+// Reads like the HTTP stream - ArduinoJson takes any class with read() and readBytes() as a stream.
+struct PayloadStream {
+    const char* pos;
+
+    int read() {
+        return *pos ? static_cast<unsigned char>(*pos++) : -1;
+    }
+
+    size_t readBytes(char* buffer, size_t length) {
+        size_t n = 0;
+        while (n < length && *pos) {
+            buffer[n++] = *pos++;
+        }
+        return n;
+    }
+};
+
+// What the accessor did before - the body into a String, then parsed in full into a 1024 byte DynamicJsonDocument.
+static ArduinoJson::DeserializationError parseBufferedWeather(const char* payload, WeatherData& weather) {
+    const std::string body(payload);
+    CountingJsonDocument doc(1024);
+    const auto res = ArduinoJson::deserializeJson(doc, body);
+    if (res.code() != ArduinoJson::DeserializationError::Ok) {
+        return res;
+    }
+    weather.maxTemp = doc["daily"]["temperature_2m_max"][0].as<float>();
+    weather.curTemp = doc["current"]["temperature_2m"].as<float>();
+    weather.minTemp = doc["daily"]["temperature_2m_min"][0].as<float>();
+    weather.weatherCode = doc["daily"]["weather_code"][0].as<int>();
+    weather.maxPercipitationProb = doc["daily"]["precipitation_probability_max"][0].as<int>();
+    weather.isValid = true;
+    return res;
+}
+
+static void report(const char* name, const char* payload) {
+    using Clock = std::chrono::steady_clock;
+    constexpr int ROUNDS = 2000;
+
+    WeatherData weather{};
+    peakHeapBytes = heapBytes;
+    auto start = Clock::now();
+    ArduinoJson::DeserializationError bufferedRes;
+    for (int round = 0; round < ROUNDS; ++round) {
+        bufferedRes = parseBufferedWeather(payload, weather);
+    }
+    const double bufferedUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / ROUNDS;
+    const size_t bufferedHeap = peakHeapBytes - heapBytes;
+
+    peakHeapBytes = heapBytes;
+    start = Clock::now();
+    ArduinoJson::DeserializationError streamedRes;
+    for (int round = 0; round < ROUNDS; ++round) {
+        // On the heap here to be counted - the device keeps it on the stack of the I/O worker.
+        CountingJsonDocument doc(WEATHER_DOC_CAPACITY);
+        PayloadStream stream{payload};
+        streamedRes = parseWeather(stream, weather, doc);
+    }
+    const double streamedUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / ROUNDS;
+    const size_t streamedHeap = peakHeapBytes - heapBytes;
+
+    char text[192];
+    snprintf(text, sizeof(text), "%s (%zu B): buffered %zu B peak, %.1f us (%s) - streamed %zu B peak + %zu B filter, "
+             "%.1f us (%s)", name, strlen(payload), bufferedHeap, bufferedUs, bufferedRes.c_str(), streamedHeap,
+             WEATHER_FILTER_CAPACITY, streamedUs, streamedRes.c_str());
+    TEST_MESSAGE(text);
+    TEST_ASSERT_TRUE(streamedRes.code() == ArduinoJson::DeserializationError::Ok);
+    TEST_ASSERT_LESS_OR_EQUAL(WEATHER_DOC_CAPACITY, streamedHeap);
+    TEST_ASSERT_LESS_THAN(bufferedHeap, streamedHeap);
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_summer_forecast() {
+    PayloadStream stream{SUMMER_PAYLOAD};
+    WeatherData weather{};
+    TEST_ASSERT_TRUE(parseWeather(stream, weather).code() == ArduinoJson::DeserializationError::Ok);
+    TEST_ASSERT_TRUE(weather.isValid);
+    TEST_ASSERT_EQUAL_FLOAT(24.3f, weather.curTemp);
+    TEST_ASSERT_EQUAL_FLOAT(27.1f, weather.maxTemp);
+    TEST_ASSERT_EQUAL_FLOAT(13.9f, weather.minTemp);
+    TEST_ASSERT_EQUAL(3, weather.weatherCode);
+    TEST_ASSERT_EQUAL(12, weather.maxPercipitationProb);
+}
+
+static void test_winter_forecast() {
+    PayloadStream stream{WINTER_PAYLOAD};
+    WeatherData weather{};
+    TEST_ASSERT_TRUE(parseWeather(stream, weather).code() == ArduinoJson::DeserializationError::Ok);
+    TEST_ASSERT_EQUAL_FLOAT(-6.8f, weather.curTemp);
+    TEST_ASSERT_EQUAL_FLOAT(-1.2f, weather.maxTemp);
+    TEST_ASSERT_EQUAL_FLOAT(-9.5f, weather.minTemp);
+    TEST_ASSERT_EQUAL(73, weather.weatherCode);
+    TEST_ASSERT_EQUAL(87, weather.maxPercipitationProb);
+}
+
+// The filter keeps the document at its compile time size whatever else the response contains.
+static void test_unrequested_fields_do_not_overflow() {
+    const std::string payload = withHourlyForecast(SUMMER_PAYLOAD);
+    PayloadStream stream{payload.c_str()};
+    WeatherData weather{};
+    TEST_ASSERT_TRUE(parseWeather(stream, weather).code() == ArduinoJson::DeserializationError::Ok);
+    TEST_ASSERT_EQUAL_FLOAT(24.3f, weather.curTemp);
+    TEST_ASSERT_EQUAL(12, weather.maxPercipitationProb);
+}
+
+static void test_truncated_response_keeps_the_weather() {
+    const std::string payload = std::string(SUMMER_PAYLOAD).substr(0, 200);
+    PayloadStream stream{payload.c_str()};
+    WeatherData weather{};
+    TEST_ASSERT_FALSE(parseWeather(stream, weather).code() == ArduinoJson::DeserializationError::Ok);
+    TEST_ASSERT_FALSE(weather.isValid);
+}
+
+static void test_benchmark_buffered_against_streamed() {
+    report("summer", SUMMER_PAYLOAD);
+    report("winter", WINTER_PAYLOAD);
+    const std::string hourly = withHourlyForecast(SUMMER_PAYLOAD);
+    report("with hourly", hourly.c_str());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_summer_forecast);
+    RUN_TEST(test_winter_forecast);
+    RUN_TEST(test_unrequested_fields_do_not_overflow);
+    RUN_TEST(test_truncated_response_keeps_the_weather);
+    RUN_TEST(test_benchmark_buffered_against_streamed);
+    return UNITY_END();
+}
@@ -0,0 +1,210 @@
+// Project: NightLight
+// Copyright: (c) 2025 Framework Labs
+
+#include "WeatherRefreshPolicy.h"
+
+#include <unity.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+
+static std::mt19937 generator(1);
+
+static long testRandom(long max) {
+    return max > 0 ? static_cast<long>(generator() % static_cast<unsigned long>(max)) : 0;
+}
+
+static constexpr time_t START = 1749427200; // Monday 2025-06-09 00:00:00 UTC
+static constexpr time_t DAY_S = 24 * 60 * 60;
+static constexpr time_t WEEK_S = 7 * DAY_S;
+static constexpr time_t FETCH_S = 2;
+static constexpr time_t STALE_S = 90 * 60; // As WeatherCache::STALE_S.
+
+// The display is off at night, from 23:00 to 06:30.
+static bool isDisplayOn(time_t t) {
+    const time_t intoDay = (t - START) % DAY_S;
+    return intoDay >= 6 * 3600 + 30 * 60 && intoDay < 23 * 3600;
+}
+
+// Synthetic outages: a short one every morning and a six hour one every other afternoon.
+static bool isOutage(time_t t) {
+    const time_t day = (t - START) / DAY_S;
+    const time_t intoDay = (t - START) % DAY_S;
+    if (intoDay >= 8 * 3600 + 30 * 60 && intoDay < 8 * 3600 + 45 * 60) {
+        return true;
+    }
+    return day % 2 == 1 && intoDay >= 14 * 3600 && intoDay < 20 * 3600;
+}
+
+struct Stats {
+    int fetches = 0;
+    int successes = 0;
+    int writes = 0;
+    int droppedHourlyWrites = 0;
+    double ageSum = 0;
+    time_t maxAge = 0;
+    int samples = 0;
+    int staleSamples = 0;
+    int misalignedSuccesses = 0;
+};
+
+// Samples the age of the shown weather every minute while the display is on.
+static void sampleAges(time_t from, time_t to, time_t fetchedAt, Stats& stats) {
+    for (time_t t = (from + 59) / 60 * 60 + 30; t < to; t += 60) {
+        if (!isDisplayOn(t)) {
+            continue;
+        }
+        const time_t age = t - fetchedAt;
+        stats.ageSum += age;
+        stats.maxAge = std::max(stats.maxAge, age);
+        stats.staleSamples += age >= STALE_S;
+        ++stats.samples;
+    }
+}
+
+// Runs the WeatherProvider loop for a week - fetches wait for the display and take FETCH_S each.
+static Stats simulatePolicy() {
+    WeatherRefreshPolicy policy(testRandom);
+    Stats stats;
+    time_t t = START;
+    time_t fetchedAt = START - DAY_S; // Restored from the flash at boot.
+    time_t writtenAt = 0;
+    time_t previousSuccess = 0;
+    bool isScheduledBySuccess = false;
+
+    while (t < START + WEEK_S) {
+        const time_t awaitStart = t;
+        while (!isDisplayOn(t)) {
+            ++t;
+        }
+        sampleAges(awaitStart, t, fetchedAt, stats);
+        if (t != awaitStart) {
+            isScheduledBySuccess = false; // The fetch waited for the display instead of the model update.
+        }
+
+        ++stats.fetches;
+        const bool isSuccess = !isOutage(t);
+        const time_t done = t + FETCH_S;
+        sampleAges(t, done, fetchedAt, stats);
+
+        uint32_t delay;
+        if (isSuccess) {
+            ++stats.successes;
+            if (isScheduledBySuccess) {
+                const time_t intoHour = done % 3600;
+                stats.misalignedSuccesses += intoHour < time_t(WeatherRefreshPolicy::MODEL_DELAY_S)
+                    || intoHour > time_t(WeatherRefreshPolicy::MODEL_DELAY_S + WeatherRefreshPolicy::SPREAD_S) + FETCH_S;
+            }
+            fetchedAt = done;
+            // As Prefs::writeWeather() rate limits the flash writes.
+            if (writtenAt == 0 || done - writtenAt >= time_t(WeatherRefreshPolicy::PERSIST_INTERVAL_S)) {
+                writtenAt = done;
+                ++stats.writes;
+            } else if (done - previousSuccess >= 50 * 60) {
+                ++stats.droppedHourlyWrites;
+            }
+            previousSuccess = done;
+            delay = policy.onSuccess(done);
+        } else {
+            delay = policy.onFailure();
+        }
+        isScheduledBySuccess = isSuccess;
+
+        t = done + delay;
+        sampleAges(done, t, fetchedAt, stats);
+    }
+    return stats;
+}
+
+// What the WeatherProvider did before: 5 tries 2 s apart, then 15 minutes after a success or 1 minute after a
+// failure - whether the display is on or not.
+static Stats simulateFixedSchedule() {
+    Stats stats;
+    time_t t = START;
+    time_t fetchedAt = START - DAY_S;
+    while (t < START + WEEK_S) {
+        bool isSuccess = false;
+        for (int attempt = 0; attempt < 5 && !isSuccess; ++attempt) {
+            ++stats.fetches;
+            isSuccess = !isOutage(t);
+            const time_t done = t + FETCH_S;
+            sampleAges(t, done, fetchedAt, stats);
+            t = done;
+            if (isSuccess) {
+                ++stats.successes;
+                fetchedAt = done;
+            } else if (attempt < 4) {
+                sampleAges(t, t + 2, fetchedAt, stats);
+                t += 2;
+            }
+        }
+        const time_t next = t + (isSuccess ? 15 * 60 : 60);
+        sampleAges(t, next, fetchedAt, stats);
+        t = next;
+    }
+    return stats;
+}
+
+static void report(const char* name, const Stats& stats) {
+    char text[192];
+    snprintf(text, sizeof(text), "%s: %d fetches (%d ok) - age while on: mean %.0f min, max %.1f h, stale %.1f %%",
+             name, stats.fetches, stats.successes, stats.ageSum / stats.samples / 60, stats.maxAge / 3600.0,
+             100.0 * stats.staleSamples / stats.samples);
+    TEST_MESSAGE(text);
+}
+
+void setUp() {}
+void tearDown() {}
+
+static void test_success_waits_for_the_next_model_update() {
+    WeatherRefreshPolicy policy(testRandom);
+    // 12:00 - the model update at 12:10 is due.
+    const time_t noon = START + 12 * 3600;
+    for (int i = 0; i < 100; ++i) {
+        const uint32_t delay = policy.onSuccess(noon);
+        TEST_ASSERT_TRUE(delay >= 10 * 60 && delay < 10 * 60 + WeatherRefreshPolicy::SPREAD_S);
+    }
+    // 12:07 - too close to it, so the one after.
+    const uint32_t delay = policy.onSuccess(noon + 7 * 60);
+    TEST_ASSERT_TRUE(delay >= 63 * 60);
+}
+
+static void test_failures_back_off_up_to_the_maximum() {
+    WeatherRefreshPolicy policy(testRandom);
+    uint32_t maxDelay = 0;
+    for (int i = 0; i < 20; ++i) {
+        const uint32_t delay = policy.onFailure();
+        TEST_ASSERT_TRUE(delay <= WeatherRefreshPolicy::MAX_RETRY_S);
+        maxDelay = std::max(maxDelay, delay);
+    }
+    TEST_ASSERT_TRUE(maxDelay >= WeatherRefreshPolicy::MAX_RETRY_S / 2);
+
+    // A success starts over.
+    policy.onSuccess(START);
+    TEST_ASSERT_TRUE(policy.onFailure() <= WeatherRefreshPolicy::FIRST_RETRY_S);
+}
+
+static void test_week_of_outages() {
+    const Stats fixed = simulateFixedSchedule();
+    const Stats stats = simulatePolicy();
+    report("fixed schedule", fixed);
+    report("refresh policy", stats);
+    char text[64];
+    snprintf(text, sizeof(text), "refresh policy: %d flash writes", stats.writes);
+    TEST_MESSAGE(text);
+
+    TEST_ASSERT_EQUAL(0, stats.misalignedSuccesses);
+    TEST_ASSERT_EQUAL(0, stats.droppedHourlyWrites);
+    TEST_ASSERT_TRUE(stats.fetches < fixed.fetches / 10);
+    // The longest outage, plus the hour before it and the longest backoff after it.
+    TEST_ASSERT_TRUE(stats.maxAge <= 6 * 3600 + 3600 + WeatherRefreshPolicy::SPREAD_S + WeatherRefreshPolicy::MAX_RETRY_S);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_success_waits_for_the_next_model_update);
+    RUN_TEST(test_failures_back_off_up_to_the_maximum);
+    RUN_TEST(test_week_of_outages);
+    return UNITY_END();
+}